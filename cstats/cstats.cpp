@@ -1,19 +1,94 @@
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include "cstats.h"
 
 using namespace std;
 
+// Merges the adjacent ascending runs [lo, mid) and [mid, hi) via a scratch buffer
+static void mergeRuns(double arr[], double buffer[], int lo, int mid, int hi) {
+    if (arr[mid - 1] <= arr[mid]) return;  // Runs are already in order
+    int i = lo, j = mid, k = lo;
+    while (i < mid && j < hi) {
+        buffer[k++] = (arr[j] < arr[i]) ? arr[j++] : arr[i++];
+    }
+    while (i < mid) buffer[k++] = arr[i++];
+    while (j < hi) buffer[k++] = arr[j++];
+    copyArray(buffer + lo, arr + lo, hi - lo);
+}
+
+// Adaptive sort: O(n) for sorted input, O(n log r) for r runs, introsort otherwise
 void sortArray(double arr[], int n) {
-    for (int i = 0; i < n - 1; i++) {
-        for (int j = 0; j < n - i - 1; j++) {
-            if (arr[j] > arr[j + 1]) {
-                double temp = arr[j];
-                arr[j] = arr[j + 1];
-                arr[j + 1] = temp;
-            }
+    if (n <= 1) return;
+    int runs = countSortedRuns(arr, n);
+    if (runs == 1) return;  // Already sorted
+
+    // Many short runs carry no useful order, so fall back to a general sort
+    if (runs > 8 + n / 64) {
+        sort(arr, arr + n);
+        return;
+    }
+
+    // Natural merge sort: record run boundaries, then merge neighbours pairwise
+    int* bounds = new int[runs + 1];
+    int r = 0;
+    bounds[r++] = 0;
+    for (int i = 1; i < n; i++) {
+        if (arr[i] < arr[i - 1]) bounds[r++] = i;
+    }
+    bounds[r] = n;
+
+    double* buffer = new double[n];
+    while (runs > 1) {
+        int merged = 0;
+        for (int k = 0; k < runs; k += 2) {
+            if (k + 1 < runs)
+                mergeRuns(arr, buffer, bounds[k], bounds[k + 1], bounds[k + 2]);
+            bounds[merged++] = bounds[k];
         }
+        bounds[merged] = n;
+        runs = merged;
+    }
+    delete[] buffer;
+    delete[] bounds;
+}
+
+// Returns true when every element is >= its predecessor
+bool isSorted(const double data[], int n) {
+    for (int i = 1; i < n; i++) {
+        if (data[i] < data[i - 1]) return false;
+    }
+    return true;
+}
+
+// Counts maximal ascending runs: 1 + number of descents
+int countSortedRuns(const double data[], int n) {
+    if (n <= 0) return 0;
+    int runs = 1;
+    for (int i = 1; i < n; i++) {
+        if (data[i] < data[i - 1]) runs++;
     }
+    return runs;
+}
+
+// (value, position) pair so the argsort compares contiguous memory
+struct RankEntry {
+    double value;
+    int index;
+};
+
+static bool rankEntryLess(const RankEntry& a, const RankEntry& b) {
+    return a.value < b.value;
+}
+
+// Linear interpolation between closest ranks of already-sorted data
+static double percentileOfSorted(const double data[], int n, double p) {
+    double index = (p / 100.0) * (n - 1);
+    int lower = (int)index;
+    int upper = lower + 1;
+    if (upper >= n) return data[n - 1];
+    double weight = index - lower;
+    return data[lower] * (1 - weight) + data[upper] * weight;
 }
 
 double mean(const double data[], int n) {
@@ -123,12 +198,7 @@ double stdev(const double data[], int n) {
 double percentile(double data[], int n, double p) {
     if (n <= 0 || p < 0 || p > 100) return 0.0;
     sortArray(data, n);
-    double index = (p / 100.0) * (n - 1);
-    int lower = (int)index;
-    int upper = lower + 1;
-    if (upper >= n) return data[n - 1];
-    double weight = index - lower;
-    return data[lower] * (1 - weight) + data[upper] * weight;
+    return percentileOfSorted(data, n, p);
 }
 
 // Calculates first quartile (25th percentile)
@@ -314,6 +384,483 @@ double confidenceInterval95Upper(const double data[], int n) {
     return m + 1.96 * se;
 }
 
+// ============================================================================
+// HYPOTHESIS TESTS
+// ============================================================================
+
+static TestResult invalidTestResult() {
+    TestResult result;
+    result.statistic = 0.0;
+    result.pValue = 1.0;
+    result.df = 0.0;
+    return result;
+}
+
+// Continued fraction for the incomplete beta function (modified Lentz method)
+double incompleteBetaFraction(double a, double b, double x) {
+    const double tiny = 1e-300;
+    const double eps = 1e-15;
+    double qab = a + b;
+    double qap = a + 1.0;
+    double qam = a - 1.0;
+    double c = 1.0;
+    double d = 1.0 - qab * x / qap;
+    if (fabs(d) < tiny) d = tiny;
+    d = 1.0 / d;
+    double h = d;
+    for (int m = 1; m <= 300; m++) {
+        int m2 = 2 * m;
+        double aa = m * (b - m) * x / ((qam + m2) * (a + m2));  // Even step
+        d = 1.0 + aa * d;
+        if (fabs(d) < tiny) d = tiny;
+        c = 1.0 + aa / c;
+        if (fabs(c) < tiny) c = tiny;
+        d = 1.0 / d;
+        h *= d * c;
+        aa = -(a + m) * (qab + m) * x / ((a + m2) * (qap + m2));  // Odd step
+        d = 1.0 + aa * d;
+        if (fabs(d) < tiny) d = tiny;
+        c = 1.0 + aa / c;
+        if (fabs(c) < tiny) c = tiny;
+        d = 1.0 / d;
+        double del = d * c;
+        h *= del;
+        if (fabs(del - 1.0) < eps) break;
+    }
+    return h;
+}
+
+// I_x(a, b) using the symmetry I_x(a, b) = 1 - I_{1-x}(b, a) for fast convergence
+double regularizedIncompleteBeta(double a, double b, double x) {
+    if (a <= 0.0 || b <= 0.0) return 0.0;
+    if (x <= 0.0) return 0.0;
+    if (x >= 1.0) return 1.0;
+    double logFront = lgamma(a + b) - lgamma(a) - lgamma(b) + a * log(x) + b * log1p(-x);
+    if (x < (a + 1.0) / (a + b + 2.0))
+        return exp(logFront) * incompleteBetaFraction(a, b, x) / a;
+    return 1.0 - exp(logFront) * incompleteBetaFraction(b, a, 1.0 - x) / b;
+}
+
+// Series expansion of P(a, x) without its prefactor, converges quickly for x < a + 1
+double lowerIncompleteGammaSeries(double a, double x) {
+    double ap = a;
+    double del = 1.0 / a;
+    double total = del;
+    for (int i = 0; i < 500; i++) {
+        ap += 1.0;
+        del *= x / ap;
+        total += del;
+        if (fabs(del) < fabs(total) * 1e-15) break;
+    }
+    return total;
+}
+
+// Continued fraction for Q(a, x) without its prefactor, converges quickly for x >= a + 1
+double upperIncompleteGammaFraction(double a, double x) {
+    const double tiny = 1e-300;
+    double b = x + 1.0 - a;
+    double c = 1.0 / tiny;
+    double d = 1.0 / b;
+    double h = d;
+    for (int i = 1; i <= 500; i++) {
+        double an = -i * (i - a);
+        b += 2.0;
+        d = an * d + b;
+        if (fabs(d) < tiny) d = tiny;
+        c = b + an / c;
+        if (fabs(c) < tiny) c = tiny;
+        d = 1.0 / d;
+        double del = d * c;
+        h *= del;
+        if (fabs(del - 1.0) < 1e-15) break;
+    }
+    return h;
+}
+
+// Common prefactor x^a e^-x / Gamma(a) of the series and the continued fraction
+static double gammaPrefactor(double a, double x) {
+    return exp(-x + a * log(x) - lgamma(a));
+}
+
+static double gammaSeries(double a, double x) {
+    return gammaPrefactor(a, x) * lowerIncompleteGammaSeries(a, x);
+}
+
+static double gammaContinuedFraction(double a, double x) {
+    return gammaPrefactor(a, x) * upperIncompleteGammaFraction(a, x);
+}
+
+double regularizedGammaP(double a, double x) {
+    if (a <= 0.0 || x <= 0.0) return 0.0;
+    if (x < a + 1.0) return gammaSeries(a, x);
+    return 1.0 - gammaContinuedFraction(a, x);
+}
+
+double regularizedGammaQ(double a, double x) {
+    if (a <= 0.0) return 0.0;
+    if (x <= 0.0) return 1.0;
+    if (x < a + 1.0) return 1.0 - gammaSeries(a, x);
+    return gammaContinuedFraction(a, x);
+}
+
+// Two-sided Student-t tail: P(|T| >= |t|) = I_{df/(df+t^2)}(df/2, 1/2)
+static double studentTTwoSided(double t, double df) {
+    return regularizedIncompleteBeta(df / 2.0, 0.5, df / (df + t * t));
+}
+
+// Welch statistic and Welch-Satterthwaite df from per-group summaries
+static TestResult welchFromMoments(double meanX, double varX, int nx,
+                                   double meanY, double varY, int ny) {
+    double vx = varX / nx;
+    double vy = varY / ny;
+    double se2 = vx + vy;
+    if (se2 <= 0.0) return invalidTestResult();
+    TestResult result;
+    result.statistic = (meanX - meanY) / sqrt(se2);
+    result.df = se2 * se2 / (vx * vx / (nx - 1) + vy * vy / (ny - 1));
+    result.pValue = studentTTwoSided(result.statistic, result.df);
+    return result;
+}
+
+// Welch's t-test: t = (mean_x - mean_y) / sqrt(s_x^2/n_x + s_y^2/n_y)
+TestResult welchTTest(const double x[], int nx, const double y[], int ny) {
+    if (nx < 2 || ny < 2) return invalidTestResult();
+    return welchFromMoments(mean(x, nx), sampleVariance(x, nx), nx,
+                            mean(y, ny), sampleVariance(y, ny), ny);
+}
+
+// Column means and sample variances of a row-major matrix in a single pass.
+// Values are shifted by the first row to keep the sum-of-squares form stable.
+static void columnMoments(const double m[], int rows, int columns,
+                          double means[], double variances[]) {
+    const double* shift = m;
+    double* sums = new double[columns];
+    double* squares = new double[columns];
+    for (int c = 0; c < columns; c++) sums[c] = squares[c] = 0.0;
+    for (int r = 1; r < rows; r++) {
+        const double* row = m + (long long)r * columns;
+        for (int c = 0; c < columns; c++) {  // Contiguous, vectorizable
+            double d = row[c] - shift[c];
+            sums[c] += d;
+            squares[c] += d * d;
+        }
+    }
+    for (int c = 0; c < columns; c++) {
+        means[c] = shift[c] + sums[c] / rows;
+        double ss = squares[c] - sums[c] * sums[c] / rows;
+        variances[c] = ss > 0.0 ? ss / (rows - 1) : 0.0;
+    }
+    delete[] sums;
+    delete[] squares;
+}
+
+// Batched Welch tests: moments of every column come from one pass per group
+void welchTTestColumns(const double a[], int na, const double b[], int nb,
+                       int columns, TestResult results[]) {
+    if (columns <= 0) return;
+    if (na < 2 || nb < 2) {
+        for (int c = 0; c < columns; c++) results[c] = invalidTestResult();
+        return;
+    }
+    double* meansA = new double[columns];
+    double* varsA = new double[columns];
+    double* meansB = new double[columns];
+    double* varsB = new double[columns];
+    columnMoments(a, na, columns, meansA, varsA);
+    columnMoments(b, nb, columns, meansB, varsB);
+    for (int c = 0; c < columns; c++) {
+        results[c] = welchFromMoments(meansA[c], varsA[c], na, meansB[c], varsB[c], nb);
+    }
+    delete[] meansA;
+    delete[] varsA;
+    delete[] meansB;
+    delete[] varsB;
+}
+
+// Copies a row-major matrix into column-major order so each column is contiguous
+static double* transposeToColumns(const double m[], int rows, int columns) {
+    double* out = new double[(size_t)rows * columns];
+    for (int r = 0; r < rows; r++) {
+        const double* row = m + (size_t)r * columns;
+        for (int c = 0; c < columns; c++) out[(size_t)c * rows + r] = row[c];
+    }
+    return out;
+}
+
+// Fills entries with x followed by y; indices below nx mark members of x
+static void fillPooledEntries(RankEntry entries[], const double x[], int nx,
+                              const double y[], int ny) {
+    for (int i = 0; i < nx; i++) {
+        entries[i].value = x[i];
+        entries[i].index = i;
+    }
+    for (int i = 0; i < ny; i++) {
+        entries[nx + i].value = y[i];
+        entries[nx + i].index = nx + i;
+    }
+}
+
+// Mann-Whitney U: rank the pooled sample once, sum the ranks of x,
+// then use the tie-corrected normal approximation with continuity correction
+static TestResult mannWhitneyPooled(RankEntry entries[], int nx, int ny) {
+    int n = nx + ny;
+    sort(entries, entries + n, rankEntryLess);
+
+    double rankSumX = 0.0;
+    double tieTerm = 0.0;  // Sum of t^3 - t over tie groups
+    int i = 0;
+    while (i < n) {
+        int j = i + 1;
+        while (j < n && entries[j].value == entries[i].value) j++;
+        double averageRank = (i + j + 1) / 2.0;
+        for (int t = i; t < j; t++) {
+            if (entries[t].index < nx) rankSumX += averageRank;
+        }
+        double t = j - i;
+        tieTerm += t * t * t - t;
+        i = j;
+    }
+
+    TestResult result;
+    result.statistic = rankSumX - nx * (nx + 1.0) / 2.0;
+    result.df = 0.0;
+    double mu = nx * (double)ny / 2.0;
+    double sigma2 = nx * (double)ny / 12.0 * ((n + 1.0) - tieTerm / ((double)n * (n - 1.0)));
+    if (n < 2 || sigma2 <= 0.0) {
+        result.pValue = 1.0;
+        return result;
+    }
+    double diff = fabs(result.statistic - mu) - 0.5;
+    if (diff < 0.0) diff = 0.0;
+    double z = diff / sqrt(sigma2);
+    result.pValue = erfc(z / sqrt(2.0));
+    return result;
+}
+
+TestResult mannWhitneyU(const double x[], int nx, const double y[], int ny) {
+    if (nx <= 0 || ny <= 0) return invalidTestResult();
+    RankEntry* entries = new RankEntry[nx + ny];
+    fillPooledEntries(entries, x, nx, y, ny);
+    TestResult result = mannWhitneyPooled(entries, nx, ny);
+    delete[] entries;
+    return result;
+}
+
+// Batched Mann-Whitney: each group is transposed once and one pooled buffer
+// is reused for every column
+void mannWhitneyUColumns(const double a[], int na, const double b[], int nb,
+                         int columns, TestResult results[]) {
+    if (columns <= 0) return;
+    if (na <= 0 || nb <= 0) {
+        for (int c = 0; c < columns; c++) results[c] = invalidTestResult();
+        return;
+    }
+    double* columnsA = transposeToColumns(a, na, columns);
+    double* columnsB = transposeToColumns(b, nb, columns);
+    RankEntry* entries = new RankEntry[na + nb];
+    for (int c = 0; c < columns; c++) {
+        fillPooledEntries(entries, columnsA + (size_t)c * na, na, columnsB + (size_t)c * nb, nb);
+        results[c] = mannWhitneyPooled(entries, na, nb);
+    }
+    delete[] entries;
+    delete[] columnsA;
+    delete[] columnsB;
+}
+
+// Asymptotic Kolmogorov distribution tail: 2 * sum (-1)^(j-1) exp(-2 j^2 lambda^2)
+static double kolmogorovTail(double lambda) {
+    if (lambda < 0.2) return 1.0;
+    double total = 0.0;
+    double sign = 1.0;
+    for (int j = 1; j <= 100; j++) {
+        double term = sign * exp(-2.0 * j * j * lambda * lambda);
+        total += term;
+        if (fabs(term) < 1e-16) break;
+        sign = -sign;
+    }
+    double p = 2.0 * total;
+    if (p < 0.0) p = 0.0;
+    if (p > 1.0) p = 1.0;
+    return p;
+}
+
+// KS two-sample on sorted samples: walk the merged order tracking the ECDF gap
+static TestResult ksTwoSampleSorted(const double xs[], int nx, const double ys[], int ny) {
+    double d = 0.0;
+    int i = 0, j = 0;
+    while (i < nx && j < ny) {
+        double v = xs[i] < ys[j] ? xs[i] : ys[j];
+        while (i < nx && xs[i] == v) i++;  // Step past ties in both samples
+        while (j < ny && ys[j] == v) j++;
+        double gap = fabs((double)i / nx - (double)j / ny);
+        if (gap > d) d = gap;
+    }
+
+    TestResult result;
+    result.statistic = d;
+    result.df = 0.0;
+    double ne = nx * (double)ny / (nx + ny);
+    double sqrtNe = sqrt(ne);
+    result.pValue = kolmogorovTail((sqrtNe + 0.12 + 0.11 / sqrtNe) * d);  // Stephens' correction
+    return result;
+}
+
+TestResult ksTwoSample(const double x[], int nx, const double y[], int ny) {
+    if (nx <= 0 || ny <= 0) return invalidTestResult();
+    double* xs = new double[nx];
+    double* ys = new double[ny];
+    copyArray(x, xs, nx);
+    copyArray(y, ys, ny);
+    sortArray(xs, nx);
+    sortArray(ys, ny);
+    TestResult result = ksTwoSampleSorted(xs, nx, ys, ny);
+    delete[] xs;
+    delete[] ys;
+    return result;
+}
+
+// Batched KS: each group is transposed once, then every column is sorted in place
+void ksTwoSampleColumns(const double a[], int na, const double b[], int nb,
+                        int columns, TestResult results[]) {
+    if (columns <= 0) return;
+    if (na <= 0 || nb <= 0) {
+        for (int c = 0; c < columns; c++) results[c] = invalidTestResult();
+        return;
+    }
+    double* columnsA = transposeToColumns(a, na, columns);
+    double* columnsB = transposeToColumns(b, nb, columns);
+    for (int c = 0; c < columns; c++) {
+        double* xs = columnsA + (size_t)c * na;
+        double* ys = columnsB + (size_t)c * nb;
+        sortArray(xs, na);
+        sortArray(ys, nb);
+        results[c] = ksTwoSampleSorted(xs, na, ys, nb);
+    }
+    delete[] columnsA;
+    delete[] columnsB;
+}
+
+// Goodness of fit: sum (O - E)^2 / E with k - 1 degrees of freedom
+TestResult chiSquareGoodnessOfFit(const double observed[], const double expected[], int k) {
+    if (k < 2) return invalidTestResult();
+    double chi2 = 0.0;
+    for (int i = 0; i < k; i++) {
+        if (expected[i] <= 0.0) return invalidTestResult();
+        double diff = observed[i] - expected[i];
+        chi2 += diff * diff / expected[i];
+    }
+    TestResult result;
+    result.statistic = chi2;
+    result.df = k - 1;
+    result.pValue = regularizedGammaQ(result.df / 2.0, chi2 / 2.0);
+    return result;
+}
+
+// Batched goodness of fit: one row-major pass accumulates every column's statistic
+void chiSquareGoodnessOfFitColumns(const double observed[], const double expected[], int k,
+                                   int columns, TestResult results[]) {
+    if (columns <= 0) return;
+    if (k < 2) {
+        for (int c = 0; c < columns; c++) results[c] = invalidTestResult();
+        return;
+    }
+    double* chi2 = new double[columns];
+    bool* valid = new bool[columns];
+    for (int c = 0; c < columns; c++) {
+        chi2[c] = 0.0;
+        valid[c] = true;
+    }
+    for (int r = 0; r < k; r++) {
+        const double* observedRow = observed + (size_t)r * columns;
+        const double* expectedRow = expected + (size_t)r * columns;
+        for (int c = 0; c < columns; c++) {
+            if (expectedRow[c] <= 0.0) {
+                valid[c] = false;
+                continue;
+            }
+            double diff = observedRow[c] - expectedRow[c];
+            chi2[c] += diff * diff / expectedRow[c];
+        }
+    }
+    for (int c = 0; c < columns; c++) {
+        if (!valid[c]) {
+            results[c] = invalidTestResult();
+            continue;
+        }
+        results[c].statistic = chi2[c];
+        results[c].df = k - 1;
+        results[c].pValue = regularizedGammaQ(results[c].df / 2.0, chi2[c] / 2.0);
+    }
+    delete[] chi2;
+    delete[] valid;
+}
+
+// Independence: expected = rowTotal * colTotal / grandTotal, df = (r-1)(c-1).
+// rowTotals and colTotals are caller-provided scratch
+static TestResult chiSquareIndependenceScratch(const double table[], int rows, int cols,
+                                               double rowTotals[], double colTotals[]) {
+    for (int r = 0; r < rows; r++) rowTotals[r] = 0.0;
+    for (int c = 0; c < cols; c++) colTotals[c] = 0.0;
+    double grandTotal = 0.0;
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            double v = table[r * cols + c];
+            rowTotals[r] += v;
+            colTotals[c] += v;
+            grandTotal += v;
+        }
+    }
+
+    TestResult result = invalidTestResult();
+    double chi2 = 0.0;
+    bool valid = grandTotal > 0.0;
+    for (int r = 0; r < rows && valid; r++) {
+        for (int c = 0; c < cols; c++) {
+            double expected = rowTotals[r] * colTotals[c] / grandTotal;
+            if (expected <= 0.0) {
+                valid = false;  // Empty row or column
+                break;
+            }
+            double diff = table[r * cols + c] - expected;
+            chi2 += diff * diff / expected;
+        }
+    }
+    if (valid) {
+        result.statistic = chi2;
+        result.df = (rows - 1) * (cols - 1);
+        result.pValue = regularizedGammaQ(result.df / 2.0, chi2 / 2.0);
+    }
+    return result;
+}
+
+TestResult chiSquareIndependence(const double table[], int rows, int cols) {
+    if (rows < 2 || cols < 2) return invalidTestResult();
+    double* rowTotals = new double[rows];
+    double* colTotals = new double[cols];
+    TestResult result = chiSquareIndependenceScratch(table, rows, cols, rowTotals, colTotals);
+    delete[] rowTotals;
+    delete[] colTotals;
+    return result;
+}
+
+// Batched independence tests over count tables stored back to back
+void chiSquareIndependenceTables(const double tables[], int count, int rows, int cols,
+                                 TestResult results[]) {
+    if (count <= 0) return;
+    if (rows < 2 || cols < 2) {
+        for (int t = 0; t < count; t++) results[t] = invalidTestResult();
+        return;
+    }
+    double* rowTotals = new double[rows];
+    double* colTotals = new double[cols];
+    for (int t = 0; t < count; t++) {
+        results[t] = chiSquareIndependenceScratch(tables + (size_t)t * rows * cols, rows, cols,
+                                                  rowTotals, colTotals);
+    }
+    delete[] rowTotals;
+    delete[] colTotals;
+}
+
 // ============================================================================
 // ROBUST STATISTICS
 // ============================================================================
@@ -346,6 +893,66 @@ double weightedMean(const double data[], const double weights[], int n) {
     return sumWeighted / sumWeights;
 }
 
+// ============================================================================
+// SORTED-INPUT FAST PATHS
+// ============================================================================
+
+// Wraps ascending data in a view and precomputes prefix sums (no sorting)
+bool makeSortedView(const double data[], int n, SortedView& view) {
+    view.data = nullptr;
+    view.prefixSums = nullptr;
+    view.n = 0;
+    if (n <= 0 || !isSorted(data, n)) return false;
+    view.prefixSums = new double[n + 1];
+    view.prefixSums[0] = 0.0;
+    cumulativeSum(data, view.prefixSums + 1, n);
+    view.data = data;
+    view.n = n;
+    return true;
+}
+
+// Releases the owned prefix sums and empties the view
+void freeSortedView(SortedView& view) {
+    delete[] view.prefixSums;
+    view.data = nullptr;
+    view.prefixSums = nullptr;
+    view.n = 0;
+}
+
+// Middle value read directly from sorted storage
+double sortedMedian(const SortedView& view) {
+    int n = view.n;
+    if (n <= 0) return 0.0;
+    if (n % 2 == 0)
+        return (view.data[n/2 - 1] + view.data[n/2]) / 2.0;
+    else
+        return view.data[n/2];
+}
+
+// Percentile by direct indexing (same interpolation as percentile())
+double sortedPercentile(const SortedView& view, double p) {
+    if (view.n <= 0 || p < 0 || p > 100) return 0.0;
+    return percentileOfSorted(view.data, view.n, p);
+}
+
+// Q3 - Q1 without sorting
+double sortedIqr(const SortedView& view) {
+    if (view.n <= 0) return 0.0;
+    return percentileOfSorted(view.data, view.n, 75.0) -
+           percentileOfSorted(view.data, view.n, 25.0);
+}
+
+// Trimmed mean as a difference of two prefix sums
+double sortedTrimmedMean(const SortedView& view, double trimPercent) {
+    int n = view.n;
+    if (n <= 0 || trimPercent < 0 || trimPercent >= 50) return 0.0;
+    int trimCount = (int)(n * trimPercent / 100.0);
+    int start = trimCount;
+    int end = n - trimCount;
+    if (end <= start) return 0.0;
+    return (view.prefixSums[end] - view.prefixSums[start]) / (end - start);
+}
+
 // ============================================================================
 // REGRESSION ANALYSIS
 // ============================================================================
@@ -404,6 +1011,412 @@ void cumulativeSum(const double data[], double result[], int n) {
     }
 }
 
+// ============================================================================
+// RANGE QUERIES
+// ============================================================================
+
+// Kahan-compensated running sum: sums[i] - errors[i] ~= values[0] + ... + values[i-1]
+static void compensatedPrefix(const double values[], double sums[], double errors[], int n) {
+    double s = 0.0;
+    double c = 0.0;
+    sums[0] = 0.0;
+    errors[0] = 0.0;
+    for (int i = 0; i < n; i++) {
+        double y = values[i] - c;
+        double t = s + y;
+        c = (t - s) - y;
+        s = t;
+        sums[i + 1] = s;
+        errors[i + 1] = c;
+    }
+}
+
+// Largest k with 2^k <= len
+static int floorLog2(int len) {
+    int k = 0;
+    while (((unsigned)len >> (k + 1)) != 0) k++;
+    return k;
+}
+
+static bool validRange(const RangeStatsIndex& index, int first, int last) {
+    return first >= 0 && last < index.n && first <= last;
+}
+
+// Builds shifted compensated prefix sums and min/max sparse tables
+bool buildRangeStatsIndex(const double data[], int n, RangeStatsIndex& index) {
+    index.prefixSums = index.prefixSumErrors = nullptr;
+    index.prefixSquares = index.prefixSquareErrors = nullptr;
+    index.minTable = index.maxTable = nullptr;
+    index.shift = 0.0;
+    index.levels = 0;
+    index.n = 0;
+    if (n <= 0) return false;
+
+    index.n = n;
+    index.shift = mean(data, n);
+    index.prefixSums = new double[n + 1];
+    index.prefixSumErrors = new double[n + 1];
+    index.prefixSquares = new double[n + 1];
+    index.prefixSquareErrors = new double[n + 1];
+
+    double* shifted = new double[n];
+    for (int i = 0; i < n; i++) shifted[i] = data[i] - index.shift;
+    compensatedPrefix(shifted, index.prefixSums, index.prefixSumErrors, n);
+    for (int i = 0; i < n; i++) shifted[i] *= shifted[i];
+    compensatedPrefix(shifted, index.prefixSquares, index.prefixSquareErrors, n);
+    delete[] shifted;
+
+    index.levels = floorLog2(n) + 1;
+    index.minTable = new double[(size_t)index.levels * n];
+    index.maxTable = new double[(size_t)index.levels * n];
+    copyArray(data, index.minTable, n);
+    copyArray(data, index.maxTable, n);
+    for (int k = 1; k < index.levels; k++) {
+        const double* prevMin = index.minTable + (size_t)(k - 1) * n;
+        const double* prevMax = index.maxTable + (size_t)(k - 1) * n;
+        double* curMin = index.minTable + (size_t)k * n;
+        double* curMax = index.maxTable + (size_t)k * n;
+        int half = 1 << (k - 1);
+        for (int i = 0; i + (1 << k) <= n; i++) {
+            curMin[i] = prevMin[i] < prevMin[i + half] ? prevMin[i] : prevMin[i + half];
+            curMax[i] = prevMax[i] > prevMax[i + half] ? prevMax[i] : prevMax[i + half];
+        }
+    }
+    return true;
+}
+
+// Frees every table and resets the index
+void freeRangeStatsIndex(RangeStatsIndex& index) {
+    delete[] index.prefixSums;
+    delete[] index.prefixSumErrors;
+    delete[] index.prefixSquares;
+    delete[] index.prefixSquareErrors;
+    delete[] index.minTable;
+    delete[] index.maxTable;
+    index.prefixSums = index.prefixSumErrors = nullptr;
+    index.prefixSquares = index.prefixSquareErrors = nullptr;
+    index.minTable = index.maxTable = nullptr;
+    index.levels = 0;
+    index.n = 0;
+}
+
+// Shifted sum of the range, corrected by the stored compensation terms
+static double shiftedRangeSum(const double sums[], const double errors[], int first, int last) {
+    return (sums[last + 1] - sums[first]) - (errors[last + 1] - errors[first]);
+}
+
+// Sum of data[first..last]: shifted sum plus count * shift
+double rangeSum(const RangeStatsIndex& index, int first, int last) {
+    if (!validRange(index, first, last)) return 0.0;
+    int count = last - first + 1;
+    return shiftedRangeSum(index.prefixSums, index.prefixSumErrors, first, last) +
+           count * index.shift;
+}
+
+// Mean of data[first..last]
+double rangeMean(const RangeStatsIndex& index, int first, int last) {
+    if (!validRange(index, first, last)) return 0.0;
+    int count = last - first + 1;
+    return index.shift +
+           shiftedRangeSum(index.prefixSums, index.prefixSumErrors, first, last) / count;
+}
+
+// Sum of squared deviations from the range mean (shift-invariant)
+static double rangeSquaredDeviations(const RangeStatsIndex& index, int first, int last) {
+    int count = last - first + 1;
+    double s = shiftedRangeSum(index.prefixSums, index.prefixSumErrors, first, last);
+    double q = shiftedRangeSum(index.prefixSquares, index.prefixSquareErrors, first, last);
+    double ss = q - s * s / count;
+    return ss > 0.0 ? ss : 0.0;  // Clamp rounding noise
+}
+
+// Population variance of data[first..last]
+double rangeVariance(const RangeStatsIndex& index, int first, int last) {
+    if (!validRange(index, first, last)) return 0.0;
+    return rangeSquaredDeviations(index, first, last) / (last - first + 1);
+}
+
+// Sample variance of data[first..last]
+double rangeSampleVariance(const RangeStatsIndex& index, int first, int last) {
+    if (!validRange(index, first, last) || last == first) return 0.0;
+    return rangeSquaredDeviations(index, first, last) / (last - first);
+}
+
+// Minimum of two overlapping power-of-two blocks covering the range
+double rangeMin(const RangeStatsIndex& index, int first, int last) {
+    if (!validRange(index, first, last)) return 0.0;
+    int k = floorLog2(last - first + 1);
+    const double* level = index.minTable + (size_t)k * index.n;
+    double a = level[first];
+    double b = level[last - (1 << k) + 1];
+    return a < b ? a : b;
+}
+
+// Maximum of two overlapping power-of-two blocks covering the range
+double rangeMax(const RangeStatsIndex& index, int first, int last) {
+    if (!validRange(index, first, last)) return 0.0;
+    int k = floorLog2(last - first + 1);
+    const double* level = index.maxTable + (size_t)k * index.n;
+    double a = level[first];
+    double b = level[last - (1 << k) + 1];
+    return a > b ? a : b;
+}
+
+// ============================================================================
+// RANK STATISTICS
+// ============================================================================
+
+// Argsort, then walk each run of equal values and give it the average rank
+void rankData(const double data[], double ranks[], int n) {
+    if (n <= 0) return;
+    RankEntry* entries = new RankEntry[n];
+    for (int i = 0; i < n; i++) {
+        entries[i].value = data[i];
+        entries[i].index = i;
+    }
+    sort(entries, entries + n, rankEntryLess);
+    int i = 0;
+    while (i < n) {
+        int j = i + 1;
+        while (j < n && entries[j].value == entries[i].value) j++;
+        double averageRank = (i + j + 1) / 2.0;  // Mean of ranks i+1 .. j
+        for (int t = i; t < j; t++) ranks[entries[t].index] = averageRank;
+        i = j;
+    }
+    delete[] entries;
+}
+
+// Spearman's rho: Pearson correlation of the ranks
+double spearmanCorrelation(const double x[], const double y[], int n) {
+    if (n <= 1) return 0.0;
+    double* rx = new double[n];
+    double* ry = new double[n];
+    rankData(x, rx, n);
+    rankData(y, ry, n);
+    double rho = correlation(rx, ry, n);
+    delete[] rx;
+    delete[] ry;
+    return rho;
+}
+
+struct RankPair {
+    double x;
+    double y;
+};
+
+static bool rankPairLess(const RankPair& a, const RankPair& b) {
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+// Number of tied pairs, sum of t(t-1)/2 over runs of equal values in sorted data
+static long long tiedPairs(const double sorted[], int n) {
+    long long ties = 0;
+    int i = 0;
+    while (i < n) {
+        int j = i + 1;
+        while (j < n && sorted[j] == sorted[i]) j++;
+        long long t = j - i;
+        ties += t * (t - 1) / 2;
+        i = j;
+    }
+    return ties;
+}
+
+// Bottom-up merge sort that returns the number of inversions (swaps)
+static long long sortCountingInversions(double arr[], int n) {
+    long long swaps = 0;
+    double* buffer = new double[n];
+    for (int width = 1; width < n; width *= 2) {
+        for (int lo = 0; lo < n - width; lo += 2 * width) {
+            int mid = lo + width;
+            int hi = mid + width < n ? mid + width : n;
+            int i = lo, j = mid, k = lo;
+            while (i < mid && j < hi) {
+                if (arr[j] < arr[i]) {
+                    swaps += mid - i;  // arr[j] jumps over every remaining left element
+                    buffer[k++] = arr[j++];
+                } else {
+                    buffer[k++] = arr[i++];
+                }
+            }
+            while (i < mid) buffer[k++] = arr[i++];
+            while (j < hi) buffer[k++] = arr[j++];
+            copyArray(buffer + lo, arr + lo, hi - lo);
+        }
+    }
+    delete[] buffer;
+    return swaps;
+}
+
+// Kendall's tau-b via Knight's algorithm:
+//   sort by (x, y), count x ties and joint ties, then count y inversions by merge sort
+double kendallTau(const double x[], const double y[], int n) {
+    if (n <= 1) return 0.0;
+    RankPair* pairs = new RankPair[n];
+    for (int i = 0; i < n; i++) {
+        pairs[i].x = x[i];
+        pairs[i].y = y[i];
+    }
+    sort(pairs, pairs + n, rankPairLess);
+
+    long long totalPairs = (long long)n * (n - 1) / 2;
+    long long xTies = 0;
+    long long jointTies = 0;
+    int i = 0;
+    while (i < n) {
+        int j = i + 1;
+        while (j < n && pairs[j].x == pairs[i].x) j++;
+        long long t = j - i;
+        xTies += t * (t - 1) / 2;
+        int a = i;
+        while (a < j) {  // Runs of equal y inside the equal-x run
+            int b = a + 1;
+            while (b < j && pairs[b].y == pairs[a].y) b++;
+            long long u = b - a;
+            jointTies += u * (u - 1) / 2;
+            a = b;
+        }
+        i = j;
+    }
+
+    double* ys = new double[n];
+    for (int t = 0; t < n; t++) ys[t] = pairs[t].y;
+    delete[] pairs;
+    long long swaps = sortCountingInversions(ys, n);
+    long long yTies = tiedPairs(ys, n);
+    delete[] ys;
+
+    double denominator = sqrt((double)(totalPairs - xTies) * (double)(totalPairs - yTies));
+    if (denominator == 0.0) return 0.0;
+    double numerator = (double)(totalPairs - xTies - yTies + jointTies) - 2.0 * (double)swaps;
+    return numerator / denominator;
+}
+
+// ============================================================================
+// STREAMING CORRELATION
+// ============================================================================
+
+// Allocates mean/co-moment storage and starts with no samples
+bool initCorrelationTracker(CorrelationTracker& tracker, int k, double decay) {
+    tracker.means = tracker.comoments = tracker.deltas = nullptr;
+    tracker.k = 0;
+    tracker.weight = 0.0;
+    tracker.decay = 1.0;
+    if (k <= 0 || !(decay > 0.0 && decay <= 1.0)) return false;
+    tracker.k = k;
+    tracker.decay = decay;
+    tracker.means = new double[k];
+    tracker.comoments = new double[(long long)k * k];
+    tracker.deltas = new double[k];
+    resetCorrelationTracker(tracker);
+    return true;
+}
+
+// Frees tracker storage
+void freeCorrelationTracker(CorrelationTracker& tracker) {
+    delete[] tracker.means;
+    delete[] tracker.comoments;
+    delete[] tracker.deltas;
+    tracker.means = tracker.comoments = tracker.deltas = nullptr;
+    tracker.k = 0;
+    tracker.weight = 0.0;
+}
+
+// Zeroes means, co-moments and weight
+void resetCorrelationTracker(CorrelationTracker& tracker) {
+    int k = tracker.k;
+    for (int i = 0; i < k; i++) tracker.means[i] = 0.0;
+    for (long long i = 0; i < (long long)k * k; i++) tracker.comoments[i] = 0.0;
+    tracker.weight = 0.0;
+}
+
+// Weighted Welford update with exponential forgetting:
+//   W' = decay*W + 1,  d = x - mean,  mean += d / W',  C = decay*C + (1 - 1/W') d d^T
+void updateCorrelationTracker(CorrelationTracker& tracker, const double sample[]) {
+    int k = tracker.k;
+    if (k <= 0) return;
+    double decay = tracker.decay;
+    tracker.weight = decay * tracker.weight + 1.0;
+    double invWeight = 1.0 / tracker.weight;
+    double scale = 1.0 - invWeight;
+
+    double* d = tracker.deltas;
+    for (int i = 0; i < k; i++) {
+        d[i] = sample[i] - tracker.means[i];
+        tracker.means[i] += d[i] * invWeight;
+    }
+
+    // Rank-1 update of the upper triangle; each row is a contiguous
+    // scale-and-add that the compiler vectorizes
+    for (int i = 0; i < k; i++) {
+        double* row = tracker.comoments + (long long)i * k;
+        double si = scale * d[i];
+        for (int j = i; j < k; j++) {
+            row[j] = decay * row[j] + si * d[j];
+        }
+    }
+}
+
+// Co-moment entry (i, j) read from the stored upper triangle
+static double trackerComoment(const CorrelationTracker& tracker, int i, int j) {
+    if (i > j) {
+        int t = i;
+        i = j;
+        j = t;
+    }
+    return tracker.comoments[(long long)i * tracker.k + j];
+}
+
+// Correlation of one pair: C_ij / sqrt(C_ii * C_jj)
+double trackerCorrelation(const CorrelationTracker& tracker, int i, int j) {
+    if (i < 0 || j < 0 || i >= tracker.k || j >= tracker.k || tracker.weight <= 0.0) return 0.0;
+    double cii = trackerComoment(tracker, i, i);
+    double cjj = trackerComoment(tracker, j, j);
+    if (cii <= 0.0 || cjj <= 0.0) return 0.0;
+    double r = trackerComoment(tracker, i, j) / sqrt(cii * cjj);
+    if (r > 1.0) r = 1.0;
+    if (r < -1.0) r = -1.0;
+    return r;
+}
+
+// Population covariance matrix: C / W, mirrored into the lower triangle
+bool trackerCovarianceMatrix(const CorrelationTracker& tracker, double result[]) {
+    int k = tracker.k;
+    if (k <= 0 || tracker.weight <= 0.0) return false;
+    double invWeight = 1.0 / tracker.weight;
+    for (int i = 0; i < k; i++) {
+        for (int j = i; j < k; j++) {
+            double c = trackerComoment(tracker, i, j) * invWeight;
+            result[(long long)i * k + j] = c;
+            result[(long long)j * k + i] = c;
+        }
+    }
+    return true;
+}
+
+// Correlation matrix: co-moments scaled by inverse standard deviations
+bool trackerCorrelationMatrix(const CorrelationTracker& tracker, double result[]) {
+    int k = tracker.k;
+    if (k <= 0 || tracker.weight <= 0.0) return false;
+    double* invSd = new double[k];
+    for (int i = 0; i < k; i++) {
+        double cii = trackerComoment(tracker, i, i);
+        invSd[i] = cii > 0.0 ? 1.0 / sqrt(cii) : 0.0;
+    }
+    for (int i = 0; i < k; i++) {
+        const double* row = tracker.comoments + (long long)i * k;
+        for (int j = i; j < k; j++) {
+            double r = row[j] * invSd[i] * invSd[j];
+            if (r > 1.0) r = 1.0;
+            if (r < -1.0) r = -1.0;
+            result[(long long)i * k + j] = r;
+            result[(long long)j * k + i] = r;
+        }
+    }
+    delete[] invSd;
+    return true;
+}
+
 // ============================================================================
 // VECTOR OPERATIONS
 // ============================================================================
@@ -13,12 +13,31 @@
 // ============================================================================
 
 /**
- * @brief Sorts an array in ascending order using bubble sort
+ * @brief Sorts an array in ascending order, adapting to existing order
  * @param arr Array to sort (modified in place)
  * @param n Number of elements in the array
+ * @note Already-sorted input returns after a single O(n) scan; input made of
+ *       a few ascending runs is merged run-by-run, anything else uses introsort
  */
 void sortArray(double arr[], int n);
 
+/**
+ * @brief Checks whether an array is in ascending (non-decreasing) order
+ * @param data Array of values
+ * @param n Number of elements
+ * @return true if sorted (or n <= 1), false otherwise
+ */
+bool isSorted(const double data[], int n);
+
+/**
+ * @brief Counts the maximal ascending runs in an array
+ * @param data Array of values
+ * @param n Number of elements
+ * @return Number of runs (1 for sorted input), or 0 if n <= 0
+ * @note Cheap O(n) presortedness measure used by sortArray()
+ */
+int countSortedRuns(const double data[], int n);
+
 // ============================================================================
 // BASIC STATISTICS
 // ============================================================================
@@ -276,6 +295,181 @@ double confidenceInterval95Lower(const double data[], int n);
  */
 double confidenceInterval95Upper(const double data[], int n);
 
+// ============================================================================
+// HYPOTHESIS TESTS
+// ============================================================================
+
+/**
+ * @brief Outcome of a statistical hypothesis test
+ * @note Invalid inputs produce statistic 0.0, pValue 1.0 (no evidence) and df 0.0
+ */
+struct TestResult {
+    double statistic;  ///< Test statistic (t, U, D or chi-square)
+    double pValue;     ///< Two-sided p-value (upper-tail for chi-square)
+    double df;         ///< Degrees of freedom, or 0.0 where not applicable
+};
+
+/**
+ * @brief Regularized incomplete beta function I_x(a, b)
+ * @param a First shape parameter (> 0)
+ * @param b Second shape parameter (> 0)
+ * @param x Evaluation point (0-1)
+ * @return I_x(a, b), or 0.0 if a or b <= 0
+ * @note Lentz continued fraction, relative accuracy about 1e-14
+ */
+double regularizedIncompleteBeta(double a, double b, double x);
+
+/**
+ * @brief Regularized lower incomplete gamma function P(a, x)
+ * @param a Shape parameter (> 0)
+ * @param x Evaluation point (>= 0)
+ * @return P(a, x), or 0.0 if a <= 0 or x <= 0
+ */
+double regularizedGammaP(double a, double x);
+
+/**
+ * @brief Regularized upper incomplete gamma function Q(a, x) = 1 - P(a, x)
+ * @param a Shape parameter (> 0)
+ * @param x Evaluation point (>= 0)
+ * @return Q(a, x), or 1.0 if x <= 0, 0.0 if a <= 0
+ * @note Computed directly (not as 1 - P) so small upper tails keep full precision
+ */
+double regularizedGammaQ(double a, double x);
+
+/**
+ * @brief Modified Lentz continued fraction behind regularizedIncompleteBeta()
+ * @param a First shape parameter (> 0)
+ * @param b Second shape parameter (> 0)
+ * @param x Evaluation point, best below (a + 1) / (a + b + 2)
+ * @return The fraction f, where I_x(a, b) = x^a (1-x)^b / (a B(a, b)) * f
+ * @note Exposed so callers that cache the lgamma normalizer (batch CDFs) share this code
+ */
+double incompleteBetaFraction(double a, double b, double x);
+
+/**
+ * @brief Series behind regularizedGammaP() for x < a + 1
+ * @return The sum s, where P(a, x) = x^a e^-x / Gamma(a) * s
+ */
+double lowerIncompleteGammaSeries(double a, double x);
+
+/**
+ * @brief Lentz continued fraction behind regularizedGammaQ() for x >= a + 1
+ * @return The fraction f, where Q(a, x) = x^a e^-x / Gamma(a) * f
+ */
+double upperIncompleteGammaFraction(double a, double x);
+
+/**
+ * @brief Welch's unequal-variance two-sample t-test (two-sided)
+ * @param x First sample
+ * @param nx Number of elements in x (>= 2)
+ * @param y Second sample
+ * @param ny Number of elements in y (>= 2)
+ * @return t statistic, p-value and Welch-Satterthwaite degrees of freedom
+ */
+TestResult welchTTest(const double x[], int nx, const double y[], int ny);
+
+/**
+ * @brief Runs Welch's t-test on every column of two row-major sample matrices
+ * @param a First group, na rows x columns (row-major)
+ * @param na Number of rows (observations) in a (>= 2)
+ * @param b Second group, nb rows x columns (row-major)
+ * @param nb Number of rows (observations) in b (>= 2)
+ * @param columns Number of metrics (columns) to test
+ * @param results Output array (must be pre-allocated with columns elements)
+ * @note One pass per group accumulates the moments of all columns at once
+ */
+void welchTTestColumns(const double a[], int na, const double b[], int nb,
+                       int columns, TestResult results[]);
+
+/**
+ * @brief Mann-Whitney U test (two-sided, normal approximation with tie correction)
+ * @param x First sample
+ * @param nx Number of elements in x
+ * @param y Second sample
+ * @param ny Number of elements in y
+ * @return U statistic for x, p-value, df 0.0
+ * @note O(n log n): one sort of the pooled samples
+ */
+TestResult mannWhitneyU(const double x[], int nx, const double y[], int ny);
+
+/**
+ * @brief Runs the Mann-Whitney U test on every column of two row-major sample matrices
+ * @param a First group, na rows x columns (row-major)
+ * @param na Number of rows (observations) in a
+ * @param b Second group, nb rows x columns (row-major)
+ * @param nb Number of rows (observations) in b
+ * @param columns Number of metrics (columns) to test
+ * @param results Output array (must be pre-allocated with columns elements)
+ * @note Each group is transposed once; the pooled rank buffer is shared by all columns
+ */
+void mannWhitneyUColumns(const double a[], int na, const double b[], int nb,
+                         int columns, TestResult results[]);
+
+/**
+ * @brief Two-sample Kolmogorov-Smirnov test (two-sided, asymptotic p-value)
+ * @param x First sample
+ * @param nx Number of elements in x
+ * @param y Second sample
+ * @param ny Number of elements in y
+ * @return D statistic (max ECDF distance), p-value, df 0.0
+ */
+TestResult ksTwoSample(const double x[], int nx, const double y[], int ny);
+
+/**
+ * @brief Runs the two-sample KS test on every column of two row-major sample matrices
+ * @param a First group, na rows x columns (row-major)
+ * @param na Number of rows (observations) in a
+ * @param b Second group, nb rows x columns (row-major)
+ * @param nb Number of rows (observations) in b
+ * @param columns Number of metrics (columns) to test
+ * @param results Output array (must be pre-allocated with columns elements)
+ * @note Each group is transposed once and its columns are sorted in place
+ */
+void ksTwoSampleColumns(const double a[], int na, const double b[], int nb,
+                        int columns, TestResult results[]);
+
+/**
+ * @brief Pearson chi-square goodness-of-fit test
+ * @param observed Observed counts per category
+ * @param expected Expected counts per category (each must be > 0)
+ * @param k Number of categories (>= 2)
+ * @return Chi-square statistic, upper-tail p-value, df = k - 1
+ */
+TestResult chiSquareGoodnessOfFit(const double observed[], const double expected[], int k);
+
+/**
+ * @brief Runs a goodness-of-fit test on every column of two row-major count matrices
+ * @param observed Observed counts, k rows (categories) x columns (row-major)
+ * @param expected Expected counts, same shape (each must be > 0)
+ * @param k Number of categories (>= 2)
+ * @param columns Number of independent tests (columns)
+ * @param results Output array (must be pre-allocated with columns elements)
+ * @note One pass over the rows accumulates the statistic of every column
+ */
+void chiSquareGoodnessOfFitColumns(const double observed[], const double expected[], int k,
+                                   int columns, TestResult results[]);
+
+/**
+ * @brief Pearson chi-square test of independence for a contingency table
+ * @param table Observed counts, rows x cols (row-major)
+ * @param rows Number of rows (>= 2)
+ * @param cols Number of columns (>= 2)
+ * @return Chi-square statistic, upper-tail p-value, df = (rows-1)(cols-1)
+ */
+TestResult chiSquareIndependence(const double table[], int rows, int cols);
+
+/**
+ * @brief Runs the independence test on count tables stored back to back
+ * @param tables count tables of rows x cols each (row-major, contiguous)
+ * @param count Number of tables
+ * @param rows Number of rows per table (>= 2)
+ * @param cols Number of columns per table (>= 2)
+ * @param results Output array (must be pre-allocated with count elements)
+ * @note Row and column total buffers are allocated once for the whole batch
+ */
+void chiSquareIndependenceTables(const double tables[], int count, int rows, int cols,
+                                 TestResult results[]);
+
 // ============================================================================
 // ROBUST STATISTICS
 // ============================================================================
@@ -298,6 +492,66 @@ double trimmedMean(double data[], int n, double trimPercent);
  */
 double weightedMean(const double data[], const double weights[], int n);
 
+// ============================================================================
+// SORTED-INPUT FAST PATHS
+// ============================================================================
+
+/**
+ * @brief Read-only view over data already sorted in ascending order
+ * @note Built by makeSortedView(); the values are borrowed, the prefix sums
+ *       are owned and must be released with freeSortedView()
+ */
+struct SortedView {
+    const double* data;    ///< Sorted values (not owned)
+    double* prefixSums;    ///< prefixSums[i] = data[0] + ... + data[i-1] (n + 1 entries)
+    int n;                 ///< Number of elements
+};
+
+/**
+ * @brief Builds a SortedView over ascending data without copying or sorting it
+ * @param data Array of values sorted in ascending order (must outlive the view)
+ * @param n Number of elements
+ * @param view Output view
+ * @return true if successful, false if n <= 0 or data is not sorted
+ */
+bool makeSortedView(const double data[], int n, SortedView& view);
+
+/**
+ * @brief Releases the prefix sums held by a SortedView
+ * @param view View to release (left empty)
+ */
+void freeSortedView(SortedView& view);
+
+/**
+ * @brief Calculates the median of sorted data in O(1)
+ * @param view Sorted view
+ * @return Median value, or 0.0 if the view is empty
+ */
+double sortedMedian(const SortedView& view);
+
+/**
+ * @brief Calculates the specified percentile of sorted data in O(1)
+ * @param view Sorted view
+ * @param p Percentile to calculate (0-100)
+ * @return Percentile value, or 0.0 if invalid parameters
+ */
+double sortedPercentile(const SortedView& view, double p);
+
+/**
+ * @brief Calculates the interquartile range of sorted data in O(1)
+ * @param view Sorted view
+ * @return IQR value, or 0.0 if the view is empty
+ */
+double sortedIqr(const SortedView& view);
+
+/**
+ * @brief Calculates the trimmed mean of sorted data in O(1) using prefix sums
+ * @param view Sorted view
+ * @param trimPercent Percentage to trim from each end (0-50)
+ * @return Trimmed mean, or 0.0 if invalid parameters
+ */
+double sortedTrimmedMean(const SortedView& view, double trimPercent);
+
 // ============================================================================
 // REGRESSION ANALYSIS
 // ============================================================================
@@ -341,6 +595,203 @@ double rSquared(const double x[], const double y[], int n);
  */
 void cumulativeSum(const double data[], double result[], int n);
 
+// ============================================================================
+// RANGE QUERIES
+// ============================================================================
+
+/**
+ * @brief Precomputed index answering statistics over subranges data[first..last]
+ * @note Built once by buildRangeStatsIndex() and released by freeRangeStatsIndex().
+ *       Sums use compensated (Kahan) prefix sums of values shifted by the overall
+ *       mean, so range variances do not suffer from catastrophic cancellation.
+ *       Min/max use a sparse table (O(n log n) build, O(1) query).
+ */
+struct RangeStatsIndex {
+    double* prefixSums;       ///< Compensated prefix sums of (data[i] - shift), n + 1 entries
+    double* prefixSumErrors;  ///< Kahan compensation terms for prefixSums
+    double* prefixSquares;    ///< Compensated prefix sums of (data[i] - shift)^2
+    double* prefixSquareErrors; ///< Kahan compensation terms for prefixSquares
+    double* minTable;         ///< Sparse table: minTable[k*n + i] = min of data[i..i+2^k-1]
+    double* maxTable;         ///< Sparse table: maxTable[k*n + i] = max of data[i..i+2^k-1]
+    double shift;             ///< Reference value subtracted before accumulating
+    int levels;               ///< Number of sparse table levels (floor(log2 n) + 1)
+    int n;                    ///< Number of elements indexed
+};
+
+/**
+ * @brief Builds a range-statistics index over a dataset
+ * @param data Array of values (copied into the index; may be freed afterwards)
+ * @param n Number of elements
+ * @param index Output index
+ * @return true if successful, false if n <= 0
+ */
+bool buildRangeStatsIndex(const double data[], int n, RangeStatsIndex& index);
+
+/**
+ * @brief Releases all memory held by a range-statistics index
+ * @param index Index to release (left empty)
+ */
+void freeRangeStatsIndex(RangeStatsIndex& index);
+
+/**
+ * @brief Sum of data[first..last] (inclusive) in O(1)
+ * @param index Range index
+ * @param first Index of first element
+ * @param last Index of last element
+ * @return Sum, or 0.0 if the range is invalid
+ */
+double rangeSum(const RangeStatsIndex& index, int first, int last);
+
+/**
+ * @brief Mean of data[first..last] (inclusive) in O(1)
+ * @param index Range index
+ * @param first Index of first element
+ * @param last Index of last element
+ * @return Mean, or 0.0 if the range is invalid
+ */
+double rangeMean(const RangeStatsIndex& index, int first, int last);
+
+/**
+ * @brief Population variance of data[first..last] (inclusive) in O(1)
+ * @param index Range index
+ * @param first Index of first element
+ * @param last Index of last element
+ * @return Variance, or 0.0 if the range is invalid
+ */
+double rangeVariance(const RangeStatsIndex& index, int first, int last);
+
+/**
+ * @brief Sample variance (n-1 denominator) of data[first..last] (inclusive) in O(1)
+ * @param index Range index
+ * @param first Index of first element
+ * @param last Index of last element
+ * @return Sample variance, or 0.0 if the range is invalid or has one element
+ */
+double rangeSampleVariance(const RangeStatsIndex& index, int first, int last);
+
+/**
+ * @brief Minimum of data[first..last] (inclusive) in O(1)
+ * @param index Range index
+ * @param first Index of first element
+ * @param last Index of last element
+ * @return Minimum, or 0.0 if the range is invalid
+ */
+double rangeMin(const RangeStatsIndex& index, int first, int last);
+
+/**
+ * @brief Maximum of data[first..last] (inclusive) in O(1)
+ * @param index Range index
+ * @param first Index of first element
+ * @param last Index of last element
+ * @return Maximum, or 0.0 if the range is invalid
+ */
+double rangeMax(const RangeStatsIndex& index, int first, int last);
+
+// ============================================================================
+// RANK STATISTICS
+// ============================================================================
+
+/**
+ * @brief Assigns 1-based ranks, giving tied values the average of their ranks
+ * @param data Array of values
+ * @param ranks Output ranks (must be pre-allocated)
+ * @param n Number of elements
+ * @note O(n log n) argsort
+ */
+void rankData(const double data[], double ranks[], int n);
+
+/**
+ * @brief Calculates Spearman's rank correlation coefficient
+ * @param x First array of values
+ * @param y Second array of values
+ * @param n Number of elements in each array
+ * @return Pearson correlation of the (tie-averaged) ranks, or 0.0 if invalid
+ */
+double spearmanCorrelation(const double x[], const double y[], int n);
+
+/**
+ * @brief Calculates Kendall's tau-b rank correlation coefficient
+ * @param x First array of values
+ * @param y Second array of values
+ * @param n Number of elements in each array
+ * @return Tau-b (-1 to 1, tie-corrected), or 0.0 if n <= 1 or either array is constant
+ * @note O(n log n) using Knight's merge-sort inversion count
+ */
+double kendallTau(const double x[], const double y[], int n);
+
+// ============================================================================
+// STREAMING CORRELATION
+// ============================================================================
+
+/**
+ * @brief Incremental co-moment matrix for k concurrent streams
+ * @note Each sample (one value per stream) costs O(k^2) via a rank-1 update of
+ *       the upper triangle; the correlation matrix is produced on demand.
+ *       With decay < 1 older samples are exponentially down-weighted.
+ */
+struct CorrelationTracker {
+    double* means;      ///< Running (weighted) mean of each stream, k entries
+    double* comoments;  ///< Upper triangle of the co-moment matrix, row-major k*k
+    double* deltas;     ///< Scratch buffer for the current sample's deviations
+    double weight;      ///< Effective number of samples (sum of decayed weights)
+    double decay;       ///< Forgetting factor in (0, 1]; 1 keeps full history
+    int k;              ///< Number of streams
+};
+
+/**
+ * @brief Initializes a correlation tracker
+ * @param tracker Tracker to initialize
+ * @param k Number of streams
+ * @param decay Forgetting factor in (0, 1]; 1.0 weights all samples equally
+ * @return true if successful, false if k <= 0 or decay is out of range
+ */
+bool initCorrelationTracker(CorrelationTracker& tracker, int k, double decay);
+
+/**
+ * @brief Releases memory held by a correlation tracker
+ * @param tracker Tracker to release (left empty)
+ */
+void freeCorrelationTracker(CorrelationTracker& tracker);
+
+/**
+ * @brief Clears all accumulated samples, keeping k and decay
+ * @param tracker Tracker to reset
+ */
+void resetCorrelationTracker(CorrelationTracker& tracker);
+
+/**
+ * @brief Adds one observation (one value per stream) in O(k^2)
+ * @param tracker Tracker to update
+ * @param sample Array of k values
+ */
+void updateCorrelationTracker(CorrelationTracker& tracker, const double sample[]);
+
+/**
+ * @brief Pearson correlation between two tracked streams
+ * @param tracker Tracker
+ * @param i First stream index
+ * @param j Second stream index
+ * @return Correlation (-1 to 1), or 0.0 if invalid or either stream has no variance
+ */
+double trackerCorrelation(const CorrelationTracker& tracker, int i, int j);
+
+/**
+ * @brief Writes the full k x k population covariance matrix
+ * @param tracker Tracker
+ * @param result Output array (must be pre-allocated with k*k elements, row-major)
+ * @return true if successful, false if no samples have been added
+ */
+bool trackerCovarianceMatrix(const CorrelationTracker& tracker, double result[]);
+
+/**
+ * @brief Writes the full k x k Pearson correlation matrix
+ * @param tracker Tracker
+ * @param result Output array (must be pre-allocated with k*k elements, row-major)
+ * @return true if successful, false if no samples have been added
+ * @note Entries involving a stream with zero variance are 0.0
+ */
+bool trackerCorrelationMatrix(const CorrelationTracker& tracker, double result[]);
+
 // ============================================================================
 // VECTOR OPERATIONS
 // ============================================================================
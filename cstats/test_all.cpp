@@ -115,6 +115,53 @@ int main() {
     double uncorY[] = {5, 4, 3, 2, 1};
     TEST_RESULT("correlation(x=[1-5], y=[5-1])", correlation(uncorX, uncorY, 5));
     
+    cout << endl << "--- RANK STATISTICS ---" << endl;
+    double tieData[] = {10, 20, 20, 30};
+    double tieRanks[4];
+    rankData(tieData, tieRanks, 4);
+    cout << "rankData([10,20,20,30]): [" << tieRanks[0] << ", " << tieRanks[1] << ", "
+         << tieRanks[2] << ", " << tieRanks[3] << "]" << endl;
+    TEST("rankData averages ties", approxEqual(tieRanks[1], 2.5) && approxEqual(tieRanks[2], 2.5));
+    double monoY[] = {1, 10, 100, 1000, 10000};
+    TEST_RESULT("spearmanCorrelation(x, 10^x)", spearmanCorrelation(x, monoY, 5));
+    TEST("spearmanCorrelation monotone", approxEqual(spearmanCorrelation(x, monoY, 5), 1.0));
+    TEST_RESULT("kendallTau(x, y=[5-1])", kendallTau(uncorX, uncorY, 5));
+    TEST("kendallTau reversed", approxEqual(kendallTau(uncorX, uncorY, 5), -1.0));
+    double tauX[] = {1, 2, 3, 4, 5, 6};
+    double tauY[] = {2, 1, 4, 3, 6, 5};
+    TEST_RESULT("kendallTau([1-6], [2,1,4,3,6,5])", kendallTau(tauX, tauY, 6));
+    TEST("kendallTau adjacent swaps", approxEqual(kendallTau(tauX, tauY, 6), 0.6));
+    double tiedX[] = {1, 1, 2, 3};
+    double tiedY[] = {1, 2, 2, 3};
+    TEST_RESULT("kendallTau tau-b with ties", kendallTau(tiedX, tiedY, 4));
+    TEST("kendallTau tau-b with ties", approxEqual(kendallTau(tiedX, tiedY, 4), 4.0 / 5.0));
+
+    cout << endl << "--- STREAMING CORRELATION ---" << endl;
+    CorrelationTracker tracker;
+    TEST("initCorrelationTracker", initCorrelationTracker(tracker, 3, 1.0));
+    double streamZ[] = {3, 1, 4, 1, 5};
+    for (int i = 0; i < 5; i++) {
+        double sample[] = {x[i], uncorY[i], streamZ[i]};
+        updateCorrelationTracker(tracker, sample);
+    }
+    TEST_RESULT("trackerCorrelation(x, y=[5-1])", trackerCorrelation(tracker, 0, 1));
+    TEST("trackerCorrelation(x, y=[5-1])", approxEqual(trackerCorrelation(tracker, 0, 1), -1.0));
+    TEST("trackerCorrelation matches correlation", approxEqual(trackerCorrelation(tracker, 0, 2), correlation(x, streamZ, 5)));
+    double corrMatrix[9];
+    double covMatrix[9];
+    TEST("trackerCorrelationMatrix", trackerCorrelationMatrix(tracker, corrMatrix));
+    TEST("correlation matrix symmetric", approxEqual(corrMatrix[5], corrMatrix[7]) && approxEqual(corrMatrix[4], 1.0));
+    TEST("trackerCovarianceMatrix", trackerCovarianceMatrix(tracker, covMatrix) && approxEqual(covMatrix[2], covariance(x, streamZ, 5)));
+    freeCorrelationTracker(tracker);
+    initCorrelationTracker(tracker, 2, 0.5);
+    for (int i = 0; i < 50; i++) {
+        double sample[] = {(double)(i % 2), (double)(i < 25 ? i % 2 : 1 - i % 2)};
+        updateCorrelationTracker(tracker, sample);
+    }
+    TEST_RESULT("trackerCorrelation(decay 0.5, regime flip)", trackerCorrelation(tracker, 0, 1));
+    TEST("decayed tracker follows recent regime", trackerCorrelation(tracker, 0, 1) < -0.99);
+    freeCorrelationTracker(tracker);
+
     cout << endl << "--- ALTERNATIVE MEANS ---" << endl;
     double posDat[] = {1, 2, 3, 4, 5};
     TEST_RESULT("geometricMean(1-5)", geometricMean(posDat, 5));
@@ -130,6 +177,79 @@ int main() {
     double m = mean(ciData, 5);
     TEST_RESULT("mean(1-5) for CI check", m);
     
+    cout << endl << "--- HYPOTHESIS TESTS ---" << endl;
+    TEST("regularizedIncompleteBeta symmetric", approxEqual(regularizedIncompleteBeta(3.0, 3.0, 0.5), 0.5));
+    TEST("regularizedGammaQ(1, x) = exp(-x)", approxEqual(regularizedGammaQ(1.0, 2.0), exp(-2.0)));
+    TEST("regularizedGammaP + Q = 1", approxEqual(regularizedGammaP(4.5, 3.0) + regularizedGammaQ(4.5, 3.0), 1.0));
+    TestResult welch = welchTTest(x, nxy, y, nxy);
+    TEST_RESULT("welchTTest(x, 2x) t", welch.statistic);
+    TEST_RESULT("welchTTest(x, 2x) df", welch.df);
+    TEST_RESULT("welchTTest(x, 2x) p", welch.pValue);
+    TEST("welchTTest(x, 2x)", approxEqual(welch.statistic, -1.897367) && approxEqual(welch.df, 5.882353));
+    TEST("Student-t critical value 2.571 (df 5) gives p = 0.05",
+         fabs(regularizedIncompleteBeta(2.5, 0.5, 5.0 / (5.0 + 2.570582 * 2.570582)) - 0.05) < 1e-5);
+    double groupA[] = {1, 10, 2, 20, 3, 30, 4, 40, 5, 50};      // 5 rows x 2 columns
+    double groupB[] = {2, 10, 4, 20, 6, 30, 8, 40, 10, 50};
+    TestResult columnResults[2];
+    welchTTestColumns(groupA, 5, groupB, 5, 2, columnResults);
+    TEST("welchTTestColumns matches welchTTest", approxEqual(columnResults[0].statistic, welch.statistic) &&
+         approxEqual(columnResults[0].pValue, welch.pValue));
+    TEST("welchTTestColumns identical column", approxEqual(columnResults[1].statistic, 0.0) &&
+         approxEqual(columnResults[1].pValue, 1.0));
+    double lowGroup[] = {1, 2, 3, 4, 5};
+    double highGroup[] = {6, 7, 8, 9, 10, 11};
+    TestResult mw = mannWhitneyU(lowGroup, 5, highGroup, 6);
+    TEST_RESULT("mannWhitneyU separated U", mw.statistic);
+    TEST_RESULT("mannWhitneyU separated p", mw.pValue);
+    TEST("mannWhitneyU separated", mw.statistic == 0.0 && approxEqual(mw.pValue, 0.008113));
+    TestResult ks = ksTwoSample(lowGroup, 5, highGroup, 6);
+    TEST_RESULT("ksTwoSample separated D", ks.statistic);
+    TEST_RESULT("ksTwoSample separated p", ks.pValue);
+    TEST("ksTwoSample separated", approxEqual(ks.statistic, 1.0) && ks.pValue < 0.05);
+    TEST("ksTwoSample identical", approxEqual(ksTwoSample(lowGroup, 5, lowGroup, 5).statistic, 0.0));
+    double observed[] = {50, 30, 20};
+    double expected[] = {40, 40, 20};
+    TestResult gof = chiSquareGoodnessOfFit(observed, expected, 3);
+    TEST_RESULT("chiSquareGoodnessOfFit chi2", gof.statistic);
+    TEST_RESULT("chiSquareGoodnessOfFit p", gof.pValue);
+    TEST("chiSquareGoodnessOfFit", approxEqual(gof.statistic, 5.0) && approxEqual(gof.pValue, exp(-2.5)));
+    double table[] = {10, 20, 30, 40};
+    TestResult indep = chiSquareIndependence(table, 2, 2);
+    TEST_RESULT("chiSquareIndependence chi2", indep.statistic);
+    TEST_RESULT("chiSquareIndependence p", indep.pValue);
+    TEST("chiSquareIndependence", approxEqual(indep.statistic, 0.793651) && indep.df == 1.0);
+    double columnsLow[] = {1, 3, 2, 1, 3, 2, 4, 1, 5, 2};       // 5 rows x 2 columns
+    double columnsHigh[] = {6, 2, 7, 1, 8, 3, 9, 2, 10, 1, 11, 3};  // 6 rows x 2 columns
+    double lowCol1[] = {3, 1, 2, 1, 2};
+    double highCol1[] = {2, 1, 3, 2, 1, 3};
+    TestResult mwColumns[2];
+    mannWhitneyUColumns(columnsLow, 5, columnsHigh, 6, 2, mwColumns);
+    TestResult mwCol1 = mannWhitneyU(lowCol1, 5, highCol1, 6);
+    TEST("mannWhitneyUColumns matches mannWhitneyU", mwColumns[0].statistic == mw.statistic &&
+         approxEqual(mwColumns[0].pValue, mw.pValue) && mwColumns[1].statistic == mwCol1.statistic &&
+         approxEqual(mwColumns[1].pValue, mwCol1.pValue));
+    TestResult ksColumns[2];
+    ksTwoSampleColumns(columnsLow, 5, columnsHigh, 6, 2, ksColumns);
+    TestResult ksCol1 = ksTwoSample(lowCol1, 5, highCol1, 6);
+    TEST("ksTwoSampleColumns matches ksTwoSample", approxEqual(ksColumns[0].statistic, ks.statistic) &&
+         approxEqual(ksColumns[0].pValue, ks.pValue) && approxEqual(ksColumns[1].statistic, ksCol1.statistic) &&
+         approxEqual(ksColumns[1].pValue, ksCol1.pValue));
+    double observedColumns[] = {50, 25, 30, 25, 20, 50};  // 3 categories x 2 columns
+    double expectedColumns[] = {40, 25, 40, 25, 20, 50};
+    TestResult gofColumns[2];
+    chiSquareGoodnessOfFitColumns(observedColumns, expectedColumns, 3, 2, gofColumns);
+    TEST("chiSquareGoodnessOfFitColumns matches chiSquareGoodnessOfFit",
+         approxEqual(gofColumns[0].statistic, gof.statistic) && approxEqual(gofColumns[0].pValue, gof.pValue) &&
+         gofColumns[1].statistic == 0.0 && approxEqual(gofColumns[1].pValue, 1.0));
+    double tables[] = {10, 20, 30, 40, 5, 5, 5, 5};
+    TestResult indepTables[2];
+    chiSquareIndependenceTables(tables, 2, 2, 2, indepTables);
+    TEST("chiSquareIndependenceTables matches chiSquareIndependence",
+         approxEqual(indepTables[0].statistic, indep.statistic) && indepTables[1].statistic == 0.0 &&
+         indepTables[1].df == 1.0);
+    TEST("chi-square critical value 3.841 (df 1) gives p = 0.05", fabs(regularizedGammaQ(0.5, 3.841459 / 2.0) - 0.05) < 1e-6);
+    TEST("welchTTest invalid input", welchTTest(x, 1, y, 5).pValue == 1.0);
+
     cout << endl << "--- ROBUST STATISTICS ---" << endl;
     double trimData[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
     TEST_RESULT("trimmedMean(1-10, 10%)", trimmedMean(trimData, 10, 10.0));
@@ -138,6 +258,31 @@ int main() {
     double weights2[] = {0, 0, 1, 0, 0};
     TEST_RESULT("weightedMean(1-5, middle only)", weightedMean(data1, weights2, n1));
     
+    cout << endl << "--- SORTED-INPUT FAST PATHS ---" << endl;
+    double sortedData[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    SortedView view;
+    TEST("makeSortedView(sorted)", makeSortedView(sortedData, 10, view));
+    TEST_RESULT("sortedMedian(1-10)", sortedMedian(view));
+    TEST("sortedMedian(1-10)", approxEqual(sortedMedian(view), 5.5));
+    TEST_RESULT("sortedPercentile(1-10, 90%)", sortedPercentile(view, 90.0));
+    TEST("sortedPercentile(1-10, 90%)", approxEqual(sortedPercentile(view, 90.0), 9.1));
+    TEST_RESULT("sortedIqr(1-10)", sortedIqr(view));
+    TEST("sortedIqr(1-10)", approxEqual(sortedIqr(view), 4.5));
+    TEST_RESULT("sortedTrimmedMean(1-10, 10%)", sortedTrimmedMean(view, 10.0));
+    TEST("sortedTrimmedMean(1-10, 10%)", approxEqual(sortedTrimmedMean(view, 10.0), 5.5));
+    freeSortedView(view);
+    double unsortedData[] = {3, 1, 2};
+    TEST("makeSortedView(unsorted) fails", !makeSortedView(unsortedData, 3, view));
+    TEST_RESULT("countSortedRuns([3,1,2])", countSortedRuns(unsortedData, 3));
+    double runData[] = {1, 4, 7, 10, 2, 5, 8, 3, 6, 9};
+    sortArray(runData, 10);
+    TEST("sortArray(3 runs) sorted", isSorted(runData, 10));
+    const int bigN = 1000;
+    double bigData[bigN];
+    for (int i = 0; i < bigN; i++) bigData[i] = (i * 7919) % bigN;
+    sortArray(bigData, bigN);
+    TEST("sortArray(scrambled 1000) sorted", isSorted(bigData, bigN) && bigData[0] == 0 && bigData[bigN - 1] == bigN - 1);
+
     cout << endl << "--- REGRESSION ANALYSIS ---" << endl;
     TEST_RESULT("linearRegressionSlope(x=[1-5], y=[2,4,6,8,10])", linearRegressionSlope(x, y, nxy));
     TEST_RESULT("linearRegressionIntercept(x=[1-5], y=[2,4,6,8,10])", linearRegressionIntercept(x, y, nxy));
@@ -154,6 +299,27 @@ int main() {
     }
     cout << "]" << endl;
     
+    cout << endl << "--- RANGE QUERIES ---" << endl;
+    double rangeData[] = {4, 8, 15, 16, 23, 42, 1, 7};
+    RangeStatsIndex rangeIndex;
+    TEST("buildRangeStatsIndex", buildRangeStatsIndex(rangeData, 8, rangeIndex));
+    TEST_RESULT("rangeMean([4..42], 1..4)", rangeMean(rangeIndex, 1, 4));
+    TEST("rangeMean matches mean", approxEqual(rangeMean(rangeIndex, 1, 4), mean(rangeData + 1, 4)));
+    TEST_RESULT("rangeVariance([4..42], 2..6)", rangeVariance(rangeIndex, 2, 6));
+    TEST("rangeVariance matches variance", approxEqual(rangeVariance(rangeIndex, 2, 6), variance(rangeData + 2, 5)));
+    TEST("rangeSampleVariance matches sampleVariance", approxEqual(rangeSampleVariance(rangeIndex, 0, 7), sampleVariance(rangeData, 8)));
+    TEST("rangeSum(0..7)", approxEqual(rangeSum(rangeIndex, 0, 7), sum(rangeData, 8)));
+    TEST_RESULT("rangeMin(1..6)", rangeMin(rangeIndex, 1, 6));
+    TEST("rangeMin(1..6)", rangeMin(rangeIndex, 1, 6) == 1);
+    TEST_RESULT("rangeMax(0..4)", rangeMax(rangeIndex, 0, 4));
+    TEST("rangeMax(0..4)", rangeMax(rangeIndex, 0, 4) == 23);
+    TEST("rangeMean invalid range", rangeMean(rangeIndex, 5, 2) == 0.0);
+    freeRangeStatsIndex(rangeIndex);
+    double offsetData[] = {1e9 + 4, 1e9 + 7, 1e9 + 13, 1e9 + 16};
+    buildRangeStatsIndex(offsetData, 4, rangeIndex);
+    TEST("rangeVariance with large offset", approxEqual(rangeVariance(rangeIndex, 0, 3), 22.5));
+    freeRangeStatsIndex(rangeIndex);
+
     cout << endl << "--- VECTOR OPERATIONS ---" << endl;
     TEST_RESULT("dotProduct([1,0,0], [0,1,0])", dotProduct(v1, v2, n3d));
     TEST_RESULT("dotProduct([1-5], [1-5])", dotProduct(x, x, 5));
@@ -0,0 +1,122 @@
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include "cstring.h"
+
+using namespace std;
+
+// Compares the scalar, word-at-a-time and SIMD kernels against glibc on
+// strings of several lengths. Build with optimizations:
+//   g++ -O2 -o benchmark benchmark.cpp cstring.cpp
+
+static volatile long long sink;  // Keeps results observable
+
+template <typename Fn>
+static double nanosPerCall(Fn fn, int repetitions) {
+    auto start = chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; r++) fn();
+    chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - start;
+    return elapsed.count() / repetitions;
+}
+
+static const char* levelName(int level) {
+    switch (level) {
+        case SIMD_SCALAR: return "scalar";
+        case SIMD_WORD: return "word";
+        case SIMD_SSE2: return "sse2";
+        case SIMD_AVX2: return "avx2";
+    }
+    return "?";
+}
+
+static void benchmarkLength(int length) {
+    vector<char> text(length + 1, 'a');
+    text[length] = '\0';
+    vector<char> other(text);
+    vector<char> dest(length + 1);
+    int repetitions = 200000000 / (length + 16);
+
+    cout << "\n--- length " << length << " (ns per call) ---\n";
+    cout << "level       length      copy   compare  findChar\n";
+    int best = setStringSimdLevel(SIMD_AVX2);
+    for (int level = SIMD_SCALAR; level <= best; level++) {
+        setStringSimdLevel(level);
+        double len = nanosPerCall([&] { sink += stringLength(text.data()); }, repetitions);
+        double copy = nanosPerCall([&] { stringCopy(dest.data(), text.data()); sink += dest[0]; }, repetitions);
+        double cmp = nanosPerCall([&] { sink += stringCompare(text.data(), other.data()); }, repetitions);
+        double find = nanosPerCall([&] { sink += findChar(text.data(), 'z'); }, repetitions);
+        printf("%-8s %9.1f %9.1f %9.1f %9.1f\n", levelName(level), len, copy, cmp, find);
+    }
+    double len = nanosPerCall([&] { sink += strlen(text.data()); }, repetitions);
+    double copy = nanosPerCall([&] { strcpy(dest.data(), text.data()); sink += dest[0]; }, repetitions);
+    double cmp = nanosPerCall([&] { sink += strcmp(text.data(), other.data()); }, repetitions);
+    double find = nanosPerCall([&] { sink += (strchr(text.data(), 'z') != nullptr); }, repetitions);
+    printf("%-8s %9.1f %9.1f %9.1f %9.1f\n", "libc", len, copy, cmp, find);
+    setStringSimdLevel(best);
+}
+
+// Length-based kernels have no libc counterpart; std::tolower is the baseline
+static void benchmarkCase(int length) {
+    vector<char> text(length + 1);
+    vector<char> word(length + 1);
+    for (int i = 0; i < length; i++) text[i] = "Content-Type: Text/HTML 42 "[i % 27];
+    for (int i = 0; i < length; i++) word[i] = "ContentType42"[i % 13];  // Validates to the end
+    int repetitions = 200000000 / (length + 16);
+
+    cout << "\n--- case/class, length " << length << " (ns per call) ---\n";
+    cout << "level      toLower  toUpper  vowels  isAlnum\n";
+    int best = setStringSimdLevel(SIMD_AVX2);
+    for (int level = SIMD_SCALAR; level <= best; level++) {
+        setStringSimdLevel(level);
+        double lower = nanosPerCall([&] { toLowerCase(text.data(), length); sink += text[0]; }, repetitions);
+        double upper = nanosPerCall([&] { toUpperCase(text.data(), length); sink += text[0]; }, repetitions);
+        double vowels = nanosPerCall([&] { sink += countVowels(makeView(text.data(), length)); }, repetitions);
+        double alnum = nanosPerCall([&] { sink += isAlphaNumeric(makeView(word.data(), length)); }, repetitions);
+        printf("%-8s %8.1f %8.1f %7.1f %8.1f\n", levelName(level), lower, upper, vowels, alnum);
+    }
+    double lower = nanosPerCall([&] {
+        for (int i = 0; i < length; i++) text[i] = (char)tolower((unsigned char)text[i]);
+        sink += text[0];
+    }, repetitions);
+    printf("%-8s %8.1f\n", "tolower", lower);
+    setStringSimdLevel(best);
+}
+
+// About one byte in four is whitespace, at pseudo-random positions so that
+// branches on the byte value mispredict as they would on real text
+static void benchmarkCompaction(int length) {
+    vector<char> text(length + 1), work(length + 1);
+    unsigned state = 12345;
+    for (int i = 0; i < length; i++) {
+        state = state * 1103515245u + 12345u;
+        text[i] = "word \tword\r\nword"[(state >> 16) % 16];
+    }
+    int repetitions = 100000000 / (length + 16);
+
+    cout << "\n--- removeChars(\" \\t\\r\\n\"), length " << length << " (ns per call) ---\n";
+    int best = setStringSimdLevel(SIMD_AVX2);
+    for (int level = SIMD_SCALAR; level <= best; level++) {
+        setStringSimdLevel(level);
+        double ns = nanosPerCall([&] {
+            sink += filterChars(work.data(), makeView(text.data(), length), makeView(" \t\r\n"));
+        }, repetitions);
+        printf("%-8s %9.1f\n", levelName(level), ns);
+    }
+    setStringSimdLevel(best);
+}
+
+int main() {
+    cout << "===============================================\n";
+    cout << "    CSTRING PRIMITIVE BENCHMARK\n";
+    cout << "===============================================\n";
+    cout << "Best supported level: " << levelName(setStringSimdLevel(SIMD_AVX2)) << "\n";
+
+    int lengths[] = {16, 256, 4096, 65536};
+    for (int length : lengths) benchmarkLength(length);
+    for (int length : lengths) benchmarkCase(length);
+    for (int length : lengths) benchmarkCompaction(length);
+    return 0;
+}
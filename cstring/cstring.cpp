@@ -2,10 +2,16 @@
 // Author: Pranjul Gupta
 
 #include "cstring.h"
+#include <cstdint>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
-// ==================== BASIC STRING OPERATIONS ====================
+// ==================== SCALAR KERNELS ====================
+// Reference byte-at-a-time implementations (SIMD_SCALAR level)
 
-int stringLength(const char str[]) {
+static int lengthScalar(const char str[]) {
     int length = 0;
     while (str[length] != '\0') {  // Loop until null terminator
         length++;
@@ -13,7 +19,7 @@ int stringLength(const char str[]) {
     return length;
 }
 
-void stringCopy(char dest[], const char src[]) {
+static void copyScalar(char dest[], const char src[]) {
     int i = 0;
     while (src[i] != '\0') {
         dest[i] = src[i];  // Copy each character
@@ -22,31 +28,21 @@ void stringCopy(char dest[], const char src[]) {
     dest[i] = '\0';  // Add null terminator
 }
 
-void stringConcat(char dest[], const char src[]) {
-    int destLen = stringLength(dest);  // Find end of dest
-    int i = 0;
-    while (src[i] != '\0') {
-        dest[destLen + i] = src[i];  // Append src to dest
-        i++;
-    }
-    dest[destLen + i] = '\0';  // Add null terminator
+// Result for the first position where the strings differ or end
+static inline int compareResult(char a, char b) {
+    if (a == b) return 0;     // Both ended
+    if (a == '\0') return -1;  // str1 is shorter
+    if (b == '\0') return 1;   // str2 is shorter
+    return a < b ? -1 : 1;
 }
 
-int stringCompare(const char str1[], const char str2[]) {
+static int compareScalar(const char str1[], const char str2[]) {
     int i = 0;
-    while (str1[i] != '\0' && str2[i] != '\0') {
-        if (str1[i] < str2[i]) return -1;  // str1 is less
-        if (str1[i] > str2[i]) return 1;   // str1 is greater
-        i++;
-    }
-    if (str1[i] == '\0' && str2[i] == '\0') return 0;  // Equal
-    if (str1[i] == '\0') return -1;  // str1 is shorter
-    return 1;  // str2 is shorter
+    while (str1[i] != '\0' && str1[i] == str2[i]) i++;
+    return compareResult(str1[i], str2[i]);
 }
 
-// ==================== STRING SEARCH OPERATIONS ====================
-
-int findChar(const char str[], char ch) {
+static int findCharScalar(const char str[], char ch) {
     for (int i = 0; str[i] != '\0'; i++) {
         if (str[i] == ch) {
             return i;  // Return index if found
@@ -55,319 +51,1244 @@ int findChar(const char str[], char ch) {
     return -1;  // Return -1 if not found
 }
 
-int findSubstring(const char str[], const char substr[]) {
-    int strLen = stringLength(str);
-    int subLen = stringLength(substr);
-    
-    if (subLen == 0) return 0;  // Empty substring found at start
-    if (subLen > strLen) return -1;  // Substring too long
-    
-    for (int i = 0; i <= strLen - subLen; i++) {
-        int j = 0;
-        while (j < subLen && str[i + j] == substr[j]) {  // Match characters
-            j++;
-        }
-        if (j == subLen) {  // Full match found
-            return i;
-        }
+// Bytes in [first, last] have bit 0x20 flipped: ASCII case conversion
+static void changeCaseScalar(char str[], int length, char first, char last) {
+    for (int i = 0; i < length; i++) {
+        if (str[i] >= first && str[i] <= last) str[i] ^= 0x20;
     }
-    return -1;  // Not found
 }
 
-// ==================== STRING MANIPULATION OPERATIONS ====================
+static inline int isVowelLetter(char ch) {
+    ch |= 0x20;  // Lowercase letters; other bytes never match
+    return ch == 'a' || ch == 'e' || ch == 'i' || ch == 'o' || ch == 'u';
+}
 
-void reverseString(char str[]) {
-    int len = stringLength(str);
-    for (int i = 0; i < len / 2; i++) {  // Swap from both ends
-        char temp = str[i];
-        str[i] = str[len - 1 - i];
-        str[len - 1 - i] = temp;
+static void countLettersScalar(const char str[], int length, int& letters, int& vowels) {
+    letters = 0;
+    vowels = 0;
+    for (int i = 0; i < length; i++) {
+        if ((str[i] >= 'a' && str[i] <= 'z') || (str[i] >= 'A' && str[i] <= 'Z')) {
+            letters++;
+            vowels += isVowelLetter(str[i]);
+        }
     }
 }
 
-void toUpperCase(char str[]) {
-    for (int i = 0; str[i] != '\0'; i++) {
-        if (str[i] >= 'a' && str[i] <= 'z') {  // Check if lowercase
-            str[i] = str[i] - 'a' + 'A';  // Convert to uppercase
-        }
+// Character classes for classSpan kernels
+static const int CLASS_ALPHA = 1;
+static const int CLASS_DIGIT = 2;
+
+// Index of the first byte outside the classes, or length
+static int classSpanScalar(const char str[], int length, int classes) {
+    for (int i = 0; i < length; i++) {
+        char ch = str[i];
+        int alpha = (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z');
+        int digit = ch >= '0' && ch <= '9';
+        if (!((alpha && (classes & CLASS_ALPHA)) || (digit && (classes & CLASS_DIGIT)))) return i;
     }
+    return length;
 }
 
-void toLowerCase(char str[]) {
-    for (int i = 0; str[i] != '\0'; i++) {
-        if (str[i] >= 'A' && str[i] <= 'Z') {  // Check if uppercase
-            str[i] = str[i] - 'A' + 'a';  // Convert to lowercase
-        }
+// Bytes removed by the compaction kernels. Built once per call; the nibble
+// rows drive the AVX2 membership test (see compactAvx2)
+struct ByteSet {
+    unsigned char member[256];      // 1 for bytes in the set
+    unsigned char members[8];       // The bytes themselves, when count <= 8
+    int count;                      // Distinct bytes in the set
+    unsigned char lowRows[16];      // lowRows[lo] bit h: byte (h << 4 | lo) is a member, h < 8
+    unsigned char highRows[16];     // Same for h >= 8 (bit h - 8)
+};
+
+static void makeByteSet(ByteSet& set, const char bytes[], int length) {
+    memset(&set, 0, sizeof(set));
+    for (int i = 0; i < length; i++) {
+        unsigned char b = (unsigned char)bytes[i];
+        if (set.member[b]) continue;
+        set.member[b] = 1;
+        if (set.count < 8) set.members[set.count] = b;
+        set.count++;
+        if (b < 0x80) set.lowRows[b & 15] |= (unsigned char)(1 << (b >> 4));
+        else set.highRows[b & 15] |= (unsigned char)(1 << ((b >> 4) - 8));
     }
 }
 
-// ==================== STRING ANALYSIS OPERATIONS ====================
+static inline int inByteSet(const ByteSet& set, char ch) {
+    return set.member[(unsigned char)ch];
+}
 
-int countVowels(const char str[]) {
-    int count = 0;
-    for (int i = 0; str[i] != '\0'; i++) {
-        char ch = str[i];
-        if (ch >= 'A' && ch <= 'Z') {  // Convert to lowercase
-            ch = ch - 'A' + 'a';
-        }
-        if (ch == 'a' || ch == 'e' || ch == 'i' || ch == 'o' || ch == 'u') {  // Check vowels
-            count++;
-        }
+// Copies the bytes of src that are not in set to dest (which may equal src)
+// and returns how many were kept. No terminator is written
+static int compactScalar(char dest[], const char src[], int length, const ByteSet& set) {
+    int j = 0;
+    for (int i = 0; i < length; i++) {
+        if (!inByteSet(set, src[i])) dest[j++] = src[i];
     }
-    return count;
+    return j;
 }
 
-int countConsonants(const char str[]) {
-    int count = 0;
-    for (int i = 0; str[i] != '\0'; i++) {
-        char ch = str[i];
-        if (ch >= 'A' && ch <= 'Z') {  // Convert to lowercase
-            ch = ch - 'A' + 'a';
-        }
-        if (ch >= 'a' && ch <= 'z' &&  // Check if letter
-            ch != 'a' && ch != 'e' && ch != 'i' && ch != 'o' && ch != 'u') {  // Not a vowel
-            count++;
-        }
+// Always stores, advancing only past kept bytes: no data-dependent branch
+static int compactBranchless(char dest[], const char src[], int length, const ByteSet& set) {
+    int j = 0;
+    for (int i = 0; i < length; i++) {
+        char ch = src[i];
+        dest[j] = ch;
+        j += 1 - inByteSet(set, ch);
     }
-    return count;
+    return j;
 }
 
-int countWords(const char str[]) {
-    int count = 0;
-    int inWord = 0;  // Track if currently in a word
-    
-    for (int i = 0; str[i] != '\0'; i++) {
-        if (str[i] != ' ' && str[i] != '\t' && str[i] != '\n') {  // Non-whitespace
-            if (!inWord) {
-                count++;  // Start of a new word
-                inWord = 1;
+// ==================== TWO-WAY SUBSTRING SEARCH ====================
+// Crochemore-Perrin: the pattern is split at a critical factorization, the
+// right half is matched left to right and the left half right to left, so no
+// text byte is compared more than twice. Before each attempt the text byte
+// under the pattern's last position is looked up in the shift table, which
+// skips ahead by up to the full pattern length (as in Horspool's algorithm).
+
+// Fills the search tables for bytes[0..length) without copying them
+static void preparePattern(SearchPattern& pattern, const char* bytes, int length) {
+    const unsigned char* n = (const unsigned char*)bytes;
+    pattern.bytes = (char*)bytes;
+    pattern.length = length;
+    for (int c = 0; c < 256; c++) pattern.shift[c] = 0;
+    for (int i = 0; i < length; i++) pattern.shift[n[i]] = i + 1;
+
+    // Maximal suffix under both byte orders; the later one is critical
+    int ip = -1, jp = 0, k = 1, p = 1;
+    while (jp + k < length) {
+        if (n[ip + k] == n[jp + k]) {
+            if (k == p) {
+                jp += p;
+                k = 1;
+            } else {
+                k++;
             }
+        } else if (n[ip + k] > n[jp + k]) {
+            jp += k;
+            k = 1;
+            p = jp - ip;
         } else {
-            inWord = 0;  // End of word
+            ip = jp++;
+            k = p = 1;
         }
     }
-    return count;
-}
+    int critical = ip, period = p;
+    ip = -1, jp = 0, k = 1, p = 1;
+    while (jp + k < length) {
+        if (n[ip + k] == n[jp + k]) {
+            if (k == p) {
+                jp += p;
+                k = 1;
+            } else {
+                k++;
+            }
+        } else if (n[ip + k] < n[jp + k]) {
+            jp += k;
+            k = 1;
+            p = jp - ip;
+        } else {
+            ip = jp++;
+            k = p = 1;
+        }
+    }
+    if (ip > critical) {
+        critical = ip;
+        period = p;
+    }
 
-int isPalindrome(const char str[]) {
-    int len = stringLength(str);
-    for (int i = 0; i < len / 2; i++) {  // Compare from both ends
-        if (str[i] != str[len - 1 - i]) {
-            return 0;  // Not a palindrome
+    // Periodic if the left half repeats one period later
+    pattern.periodic = 1;
+    for (int i = 0; i <= critical; i++) {
+        if (n[i] != n[i + period]) {
+            pattern.periodic = 0;
+            break;
         }
     }
-    return 1;  // Is a palindrome
+    if (!pattern.periodic) {
+        int left = critical + 1, right = length - critical - 1;
+        period = (left > right ? left : right) + 1;
+    }
+    pattern.critical = critical;
+    pattern.period = period;
 }
 
-// ==================== STRING UTILITY OPERATIONS ====================
-
-void removeSpaces(char str[]) {
-    int i = 0, j = 0;  // i reads, j writes
-    while (str[i] != '\0') {
-        if (str[i] != ' ') {  // Skip spaces
-            str[j] = str[i];
-            j++;
+static int twoWaySearch(const SearchPattern& pattern, const char text[], int length, int start) {
+    const unsigned char* n = (const unsigned char*)pattern.bytes;
+    const unsigned char* h = (const unsigned char*)text;
+    int m = pattern.length, critical = pattern.critical;
+    int memory0 = pattern.periodic ? m - pattern.period : 0;
+    int memory = 0;  // Prefix already known to match (periodic patterns)
+    for (int pos = start; pos <= length - m;) {
+        int skip = m - pattern.shift[h[pos + m - 1]];
+        if (skip != 0) {
+            pos += skip > memory ? skip : memory;
+            memory = 0;
+            continue;
         }
-        i++;
+        int k = critical + 1 > memory ? critical + 1 : memory;
+        while (k < m && n[k] == h[pos + k]) k++;
+        if (k < m) {
+            pos += k - critical;
+            memory = 0;
+            continue;
+        }
+        for (k = critical + 1; k > memory && n[k - 1] == h[pos + k - 1]; k--) {
+        }
+        if (k <= memory) return pos;
+        pos += pattern.period;
+        memory = memory0;
     }
-    str[j] = '\0';  // Terminate string
+    return -1;
 }
 
-void trimString(char str[]) {
-    int start = 0;
-    int len = stringLength(str);
-    
-    while (str[start] == ' ' || str[start] == '\t') {  // Skip leading whitespace
-        start++;
+// ==================== WORD-AT-A-TIME KERNELS ====================
+// Eight bytes per step in a 64-bit register (SIMD_WORD level, any CPU).
+// Loads are aligned to their own width, so they never cross into an unmapped
+// page even when they read past the terminator; the same holds for the wider
+// SIMD loads below. Sanitizers cannot tell this apart from a real overread.
+// Length and findChar share one scan for "first byte equal to 0 or ch"
+// (ch = 0 gives the length).
+
+#if defined(__GNUC__) || defined(__clang__)
+#define CSTRING_OVERREAD __attribute__((no_sanitize_address))
+#else
+#define CSTRING_OVERREAD
+#endif
+
+static const uint64_t ONES = 0x0101010101010101ULL;
+static const uint64_t HIGHS = 0x8080808080808080ULL;
+static const uintptr_t PAGE_SIZE = 4096;
+
+// Non-zero if any byte of v is zero
+static inline uint64_t zeroBytes(uint64_t v) {
+    return (v - ONES) & ~v & HIGHS;
+}
+
+// Marked like its callers: it is not always inlined into them
+CSTRING_OVERREAD static inline uint64_t loadWord(const char* p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// Bytes that can be read from p without crossing into the next page
+static inline uintptr_t roomInPage(const char* p) {
+    return PAGE_SIZE - ((uintptr_t)p & (PAGE_SIZE - 1));
+}
+
+static inline int finishFind(const char* str, const char* hit, char ch) {
+    if (ch == '\0') return (int)(hit - str);
+    return *hit == ch ? (int)(hit - str) : -1;
+}
+
+CSTRING_OVERREAD static const char* scanWord(const char* p, char ch) {
+    for (; ((uintptr_t)p & 7) != 0; p++) {
+        if (*p == ch || *p == '\0') return p;
     }
-    
-    int end = len - 1;
-    while (end >= start && (str[end] == ' ' || str[end] == '\t')) {  // Skip trailing whitespace
-        end--;
+    uint64_t pattern = ONES * (unsigned char)ch;
+    for (;;) {
+        uint64_t v = loadWord(p);
+        if ((zeroBytes(v) | zeroBytes(v ^ pattern)) != 0) break;
+        p += 8;
     }
-    
-    int i = 0;
-    for (int j = start; j <= end; j++) {  // Copy trimmed string
-        str[i] = str[j];
-        i++;
+    while (*p != ch && *p != '\0') p++;
+    return p;
+}
+
+CSTRING_OVERREAD static int lengthWord(const char str[]) {
+    const char* p = str;
+    for (; ((uintptr_t)p & 7) != 0; p++) {
+        if (*p == '\0') return (int)(p - str);
     }
-    str[i] = '\0';  // Terminate string
+    while (zeroBytes(loadWord(p)) == 0) p += 8;
+    while (*p != '\0') p++;
+    return (int)(p - str);
 }
 
-// ==================== ADVANCED STRING SEARCH ====================
+static int findCharWord(const char str[], char ch) {
+    return finishFind(str, scanWord(str, ch), ch);
+}
 
-int countOccurrences(const char str[], char ch) {
-    int count = 0;
-    for (int i = 0; str[i] != '\0'; i++) {
-        if (str[i] == ch) {  // Match found
-            count++;
+CSTRING_OVERREAD static void copyWord(char dest[], const char src[]) {
+    int i = 0;
+    for (; ((uintptr_t)(src + i) & 7) != 0; i++) {
+        dest[i] = src[i];
+        if (src[i] == '\0') return;
+    }
+    for (;;) {
+        uint64_t v = loadWord(src + i);
+        if (zeroBytes(v) != 0) break;
+        memcpy(dest + i, &v, sizeof(v));
+        i += 8;
+    }
+    copyScalar(dest + i, src + i);
+}
+
+// The two strings have unrelated alignment, so unaligned loads are used only
+// while both stay inside their current page; the bytes straddling a page
+// boundary are compared one at a time
+CSTRING_OVERREAD static int compareWord(const char str1[], const char str2[]) {
+    int i = 0;
+    for (;;) {
+        uintptr_t room1 = roomInPage(str1 + i), room2 = roomInPage(str2 + i);
+        uintptr_t room = room1 < room2 ? room1 : room2;
+        for (; room >= 8; room -= 8, i += 8) {
+            uint64_t a = loadWord(str1 + i);
+            if (a != loadWord(str2 + i) || zeroBytes(a) != 0) return compareScalar(str1 + i, str2 + i);
+        }
+        for (; room > 0; room--, i++) {
+            if (str1[i] == '\0' || str1[i] != str2[i]) return compareResult(str1[i], str2[i]);
         }
     }
-    return count;
 }
 
-int stringContains(const char str[], const char substr[]) {
-    return findSubstring(str, substr) != -1;  // Returns 1 if found, 0 otherwise
+// Case conversion and classification test bytes against ASCII ranges without
+// carries between bytes: the high bit of each byte of the result is set
+// exactly when that byte of v lies in [first, last] (0 < first <= last < 0x80)
+static inline uint64_t rangeBytes(uint64_t v, unsigned char first, unsigned char last) {
+    uint64_t low = v & ~HIGHS;
+    uint64_t atLeastFirst = low + ONES * (0x80 - first);
+    uint64_t aboveLast = low + ONES * (0x7f - last);
+    return atLeastFirst & ~aboveLast & ~v & HIGHS;
 }
 
-// ==================== STRING MODIFICATION ====================
+// High bit set exactly in the bytes of v equal to ch
+static inline uint64_t equalBytes(uint64_t v, unsigned char ch) {
+    uint64_t y = v ^ (ONES * ch);
+    return ~(((y & ~HIGHS) + ~HIGHS) | y) & HIGHS;
+}
 
-void stringNCopy(char dest[], const char src[], int n) {
+// Number of high bits set in a byte mask
+static inline int countMaskBytes(uint64_t mask) {
+    return (int)(((mask >> 7) * ONES) >> 56);
+}
+
+static void changeCaseWord(char str[], int length, char first, char last) {
     int i = 0;
-    while (i < n && src[i] != '\0') {  // Copy up to n characters
-        dest[i] = src[i];
-        i++;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t v = loadWord(str + i);
+        v ^= rangeBytes(v, (unsigned char)first, (unsigned char)last) >> 2;  // 0x80 >> 2 = 0x20
+        memcpy(str + i, &v, sizeof(v));
     }
-    dest[i] = '\0';  // Null terminate
+    changeCaseScalar(str + i, length - i, first, last);
 }
 
-void stringNConcat(char dest[], const char src[], int n) {
-    int destLen = stringLength(dest);  // Find end of dest
+static void countLettersWord(const char str[], int length, int& letters, int& vowels) {
     int i = 0;
-    while (i < n && src[i] != '\0') {  // Append up to n characters
-        dest[destLen + i] = src[i];
-        i++;
+    letters = 0;
+    vowels = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t lower = loadWord(str + i) | (ONES * 0x20);
+        uint64_t letter = rangeBytes(lower, 'a', 'z');
+        uint64_t vowel = equalBytes(lower, 'a') | equalBytes(lower, 'e') | equalBytes(lower, 'i') |
+                         equalBytes(lower, 'o') | equalBytes(lower, 'u');
+        letters += countMaskBytes(letter);
+        vowels += countMaskBytes(vowel & letter);
     }
-    dest[destLen + i] = '\0';  // Null terminate
+    int restLetters, restVowels;
+    countLettersScalar(str + i, length - i, restLetters, restVowels);
+    letters += restLetters;
+    vowels += restVowels;
 }
 
-void replaceChar(char str[], char oldChar, char newChar) {
-    for (int i = 0; str[i] != '\0'; i++) {
-        if (str[i] == oldChar) {  // Found character to replace
-            str[i] = newChar;
-        }
-    }
+static inline uint64_t classBytes(uint64_t v, int classes) {
+    uint64_t mask = 0;
+    if (classes & CLASS_ALPHA) mask |= rangeBytes(v | (ONES * 0x20), 'a', 'z');
+    if (classes & CLASS_DIGIT) mask |= rangeBytes(v, '0', '9');
+    return mask;
 }
 
-void insertString(char str[], const char insert[], int pos) {
-    int strLen = stringLength(str);
-    int insertLen = stringLength(insert);
-    
-    if (pos < 0 || pos > strLen) return;  // Validate position
-    
-    for (int i = strLen; i >= pos; i--) {  // Shift characters right
-        str[i + insertLen] = str[i];
+static int classSpanWord(const char str[], int length, int classes) {
+    int i = 0;
+    for (; i + 8 <= length; i += 8) {
+        if (classBytes(loadWord(str + i), classes) != HIGHS) break;
     }
-    
-    for (int i = 0; i < insertLen; i++) {  // Insert new string
-        str[pos + i] = insert[i];
+    return i + classSpanScalar(str + i, length - i, classes);
+}
+
+// Words without any member byte are copied whole (sets of up to 8 bytes are
+// detected with equalBytes); the rest are compacted branchlessly
+static int compactWord(char dest[], const char src[], int length, const ByteSet& set) {
+    if (set.count > 8) return compactBranchless(dest, src, length, set);
+    int i = 0, j = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t v = loadWord(src + i);
+        uint64_t hits = 0;
+        for (int s = 0; s < set.count; s++) hits |= equalBytes(v, set.members[s]);
+        if (hits == 0) {
+            memcpy(dest + j, &v, sizeof(v));
+            j += 8;
+        } else {
+            j += compactBranchless(dest + j, src + i, 8, set);
+        }
     }
+    return j + compactBranchless(dest + j, src + i, length - i, set);
 }
 
-// ==================== STRING EXTRACTION ====================
+// ==================== SSE2 / AVX2 KERNELS ====================
+// Aligned vector loads with the bytes before the string start masked off.
+// Long scans test four vectors per iteration inside a block aligned to four
+// vector widths (so the block never straddles a page): a byte of
+// min(v ^ ch, v) is zero exactly when that byte of v is 0 or ch.
+// The AVX2 versions are compiled for that target only and chosen at runtime.
 
-void substring(const char str[], int start, int length, char result[]) {
-    int strLen = stringLength(str);
-    
-    if (start < 0 || start >= strLen || length <= 0) {  // Validate parameters
-        result[0] = '\0';
-        return;
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define CSTRING_X86_SIMD 1
+#include <immintrin.h>
+
+static inline int lowestBit(unsigned mask) {
+    return __builtin_ctz(mask);
+}
+
+static inline unsigned stopMaskSse2(__m128i v, __m128i needle) {
+    __m128i stops = _mm_min_epu8(_mm_xor_si128(v, needle), v);
+    return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(stops, _mm_setzero_si128()));
+}
+
+CSTRING_OVERREAD static const char* scanSse2(const char* str, char ch) {
+    const __m128i needle = _mm_set1_epi8(ch);
+    uintptr_t offset = (uintptr_t)str & 15;
+    const char* p = str - offset;
+    unsigned mask = stopMaskSse2(_mm_load_si128((const __m128i*)p), needle) >> offset;
+    if (mask != 0) return str + lowestBit(mask);
+    for (p += 16; ((uintptr_t)p & 63) != 0; p += 16) {
+        mask = stopMaskSse2(_mm_load_si128((const __m128i*)p), needle);
+        if (mask != 0) return p + lowestBit(mask);
     }
-    
-    int i = 0;
-    while (i < length && str[start + i] != '\0') {  // Extract substring
-        result[i] = str[start + i];
-        i++;
+    for (;; p += 64) {
+        __m128i a = _mm_load_si128((const __m128i*)p);
+        __m128i b = _mm_load_si128((const __m128i*)(p + 16));
+        __m128i c = _mm_load_si128((const __m128i*)(p + 32));
+        __m128i d = _mm_load_si128((const __m128i*)(p + 48));
+        __m128i stops = _mm_min_epu8(_mm_min_epu8(_mm_min_epu8(_mm_xor_si128(a, needle), a),
+                                                  _mm_min_epu8(_mm_xor_si128(b, needle), b)),
+                                     _mm_min_epu8(_mm_min_epu8(_mm_xor_si128(c, needle), c),
+                                                  _mm_min_epu8(_mm_xor_si128(d, needle), d)));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(stops, _mm_setzero_si128())) != 0) break;
+    }
+    for (;; p += 16) {
+        mask = stopMaskSse2(_mm_load_si128((const __m128i*)p), needle);
+        if (mask != 0) return p + lowestBit(mask);
     }
-    result[i] = '\0';  // Null terminate
 }
 
-// ==================== STRING VALIDATION ====================
+static int lengthSse2(const char str[]) {
+    return (int)(scanSse2(str, '\0') - str);
+}
 
-int isAlpha(const char str[]) {
-    if (str[0] == '\0') return 0;  // Empty string
-    for (int i = 0; str[i] != '\0'; i++) {
-        if (!((str[i] >= 'a' && str[i] <= 'z') || (str[i] >= 'A' && str[i] <= 'Z'))) {  // Not a letter
-            return 0;
-        }
-    }
-    return 1;  // All alphabetic
+static int findCharSse2(const char str[], char ch) {
+    return finishFind(str, scanSse2(str, ch), ch);
 }
 
-int isDigit(const char str[]) {
-    if (str[0] == '\0') return 0;  // Empty string
-    for (int i = 0; str[i] != '\0'; i++) {
-        if (!(str[i] >= '0' && str[i] <= '9')) {  // Not a digit
-            return 0;
+// The first vector is loaded unaligned when the page allows, and the block
+// holding the terminator is finished with one memcpy
+CSTRING_OVERREAD static void copySse2(char dest[], const char src[]) {
+    const __m128i zero = _mm_setzero_si128();
+    int i = 0;
+    if (roomInPage(src) >= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)src);
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero));
+        if (mask != 0) {
+            memcpy(dest, src, lowestBit(mask) + 1);
+            return;
+        }
+        _mm_storeu_si128((__m128i*)dest, v);
+        i = 16 - (int)((uintptr_t)src & 15);
+    }
+    for (; ((uintptr_t)(src + i) & 15) != 0; i++) {
+        dest[i] = src[i];
+        if (src[i] == '\0') return;
+    }
+    for (;;) {
+        __m128i v = _mm_load_si128((const __m128i*)(src + i));
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero));
+        if (mask != 0) {
+            memcpy(dest + i, src + i, lowestBit(mask) + 1);
+            return;
         }
+        _mm_storeu_si128((__m128i*)(dest + i), v);
+        i += 16;
     }
-    return 1;  // All digits
 }
 
-int isAlphaNumeric(const char str[]) {
-    if (str[0] == '\0') return 0;  // Empty string
-    for (int i = 0; str[i] != '\0'; i++) {
-        if (!((str[i] >= 'a' && str[i] <= 'z') ||  // Not letter or digit
-              (str[i] >= 'A' && str[i] <= 'Z') || 
-              (str[i] >= '0' && str[i] <= '9'))) {
-            return 0;
+CSTRING_OVERREAD static int compareSse2(const char str1[], const char str2[]) {
+    const __m128i zero = _mm_setzero_si128();
+    int i = 0;
+    for (;;) {
+        uintptr_t room1 = roomInPage(str1 + i), room2 = roomInPage(str2 + i);
+        uintptr_t room = room1 < room2 ? room1 : room2;
+        for (; room >= 16; room -= 16, i += 16) {
+            __m128i a = _mm_loadu_si128((const __m128i*)(str1 + i));
+            __m128i b = _mm_loadu_si128((const __m128i*)(str2 + i));
+            unsigned stop = ((unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) ^ 0xffffu) |
+                            (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(a, zero));
+            if (stop != 0) {
+                i += lowestBit(stop);
+                return compareResult(str1[i], str2[i]);
+            }
+        }
+        for (; room > 0; room--, i++) {
+            if (str1[i] == '\0' || str1[i] != str2[i]) return compareResult(str1[i], str2[i]);
         }
     }
-    return 1;  // All alphanumeric
 }
 
-// ==================== CHARACTER TYPE CHECKING ====================
+#define CSTRING_AVX2 __attribute__((target("avx2")))
 
-int isCharAlpha(char ch) {
-    return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z');  // Check if letter
+CSTRING_AVX2 static inline unsigned stopMaskAvx2(__m256i v, __m256i needle) {
+    __m256i stops = _mm256_min_epu8(_mm256_xor_si256(v, needle), v);
+    return (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(stops, _mm256_setzero_si256()));
 }
 
-int isCharDigit(char ch) {
-    return ch >= '0' && ch <= '9';  // Check if digit
+CSTRING_AVX2 CSTRING_OVERREAD static const char* scanAvx2(const char* str, char ch) {
+    const __m256i needle = _mm256_set1_epi8(ch);
+    uintptr_t offset = (uintptr_t)str & 31;
+    const char* p = str - offset;
+    unsigned mask = stopMaskAvx2(_mm256_load_si256((const __m256i*)p), needle) >> offset;
+    if (mask != 0) return str + lowestBit(mask);
+    for (p += 32; ((uintptr_t)p & 127) != 0; p += 32) {
+        mask = stopMaskAvx2(_mm256_load_si256((const __m256i*)p), needle);
+        if (mask != 0) return p + lowestBit(mask);
+    }
+    for (;; p += 128) {
+        __m256i a = _mm256_load_si256((const __m256i*)p);
+        __m256i b = _mm256_load_si256((const __m256i*)(p + 32));
+        __m256i c = _mm256_load_si256((const __m256i*)(p + 64));
+        __m256i d = _mm256_load_si256((const __m256i*)(p + 96));
+        __m256i stops = _mm256_min_epu8(
+            _mm256_min_epu8(_mm256_min_epu8(_mm256_xor_si256(a, needle), a),
+                            _mm256_min_epu8(_mm256_xor_si256(b, needle), b)),
+            _mm256_min_epu8(_mm256_min_epu8(_mm256_xor_si256(c, needle), c),
+                            _mm256_min_epu8(_mm256_xor_si256(d, needle), d)));
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(stops, _mm256_setzero_si256())) != 0) break;
+    }
+    for (;; p += 32) {
+        mask = stopMaskAvx2(_mm256_load_si256((const __m256i*)p), needle);
+        if (mask != 0) return p + lowestBit(mask);
+    }
 }
 
-int isCharWhitespace(char ch) {
-    return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r';  // Check if whitespace
+static int lengthAvx2(const char str[]) {
+    return (int)(scanAvx2(str, '\0') - str);
 }
 
-// ==================== STRING CONVERSION ====================
+static int findCharAvx2(const char str[], char ch) {
+    return finishFind(str, scanAvx2(str, ch), ch);
+}
 
-void intToString(int num, char str[]) {
+// The first vector is loaded unaligned when the page allows, and the block
+// holding the terminator is finished with one memcpy
+CSTRING_AVX2 CSTRING_OVERREAD static void copyAvx2(char dest[], const char src[]) {
+    const __m256i zero = _mm256_setzero_si256();
     int i = 0;
-    int isNegative = 0;
-    
-    if (num == 0) {  // Handle zero case
-        str[0] = '0';
-        str[1] = '\0';
-        return;
-    }
-    
-    if (num < 0) {  // Handle negative numbers
-        isNegative = 1;
-        num = -num;
+    if (roomInPage(src) >= 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)src);
+        unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, zero));
+        if (mask != 0) {
+            memcpy(dest, src, lowestBit(mask) + 1);
+            return;
+        }
+        _mm256_storeu_si256((__m256i*)dest, v);
+        i = 32 - (int)((uintptr_t)src & 31);
     }
-    
-    while (num > 0) {  // Extract digits in reverse
-        str[i++] = (num % 10) + '0';
-        num /= 10;
+    for (; ((uintptr_t)(src + i) & 31) != 0; i++) {
+        dest[i] = src[i];
+        if (src[i] == '\0') return;
     }
-    
-    if (isNegative) {  // Add minus sign
-        str[i++] = '-';
+    for (;;) {
+        __m256i v = _mm256_load_si256((const __m256i*)(src + i));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, zero));
+        if (mask != 0) {
+            memcpy(dest + i, src + i, lowestBit(mask) + 1);
+            return;
+        }
+        _mm256_storeu_si256((__m256i*)(dest + i), v);
+        i += 32;
     }
-    
-    str[i] = '\0';
-    
-    reverseString(str);  // Reverse to get correct order
 }
 
-int stringToInt(const char str[]) {
-    int result = 0;
-    int sign = 1;
+CSTRING_AVX2 CSTRING_OVERREAD static int compareAvx2(const char str1[], const char str2[]) {
+    const __m256i zero = _mm256_setzero_si256();
     int i = 0;
-    
-    while (str[i] == ' ' || str[i] == '\t') {  // Skip whitespace
-        i++;
-    }
-    
-    if (str[i] == '-') {  // Handle sign
-        sign = -1;
-        i++;
-    } else if (str[i] == '+') {
-        i++;
+    for (;;) {
+        uintptr_t room1 = roomInPage(str1 + i), room2 = roomInPage(str2 + i);
+        uintptr_t room = room1 < room2 ? room1 : room2;
+        for (; room >= 32; room -= 32, i += 32) {
+            __m256i a = _mm256_loadu_si256((const __m256i*)(str1 + i));
+            __m256i b = _mm256_loadu_si256((const __m256i*)(str2 + i));
+            unsigned stop = ~(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)) |
+                            (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, zero));
+            if (stop != 0) {
+                i += lowestBit(stop);
+                return compareResult(str1[i], str2[i]);
+            }
+        }
+        for (; room > 0; room--, i++) {
+            if (str1[i] == '\0' || str1[i] != str2[i]) return compareResult(str1[i], str2[i]);
+        }
     }
-    
-    while (str[i] >= '0' && str[i] <= '9') {  // Convert digits
+}
+// First/last-byte candidate filter: positions where both the first and the
+// last pattern byte match are verified with memcmp. Adversarial texts (for
+// example runs of the first byte) produce many false candidates, so once they
+// outnumber one per 8 scanned bytes the rest of the text goes to Two-Way.
+static const int FILTER_SLACK = 64;
+
+static inline bool verifyCandidate(const SearchPattern& pattern, const char* at) {
+    return memcmp(at + 1, pattern.bytes + 1, pattern.length - 2) == 0;
+}
+
+static int filterSearchSse2(const SearchPattern& pattern, const char text[], int length, int start) {
+    int m = pattern.length;
+    if (m < 2) return twoWaySearch(pattern, text, length, start);
+    const __m128i first = _mm_set1_epi8(pattern.bytes[0]);
+    const __m128i last = _mm_set1_epi8(pattern.bytes[m - 1]);
+    long long falseCandidates = 0;
+    int pos = start;
+    for (; pos + 16 + m - 1 <= length; pos += 16) {
+        __m128i a = _mm_loadu_si128((const __m128i*)(text + pos));
+        __m128i b = _mm_loadu_si128((const __m128i*)(text + pos + m - 1));
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first),
+                                                                  _mm_cmpeq_epi8(b, last)));
+        while (mask != 0) {
+            int candidate = pos + lowestBit(mask);
+            if (verifyCandidate(pattern, text + candidate)) return candidate;
+            falseCandidates++;
+            mask &= mask - 1;
+        }
+        if (falseCandidates * 8 > pos - start + FILTER_SLACK) return twoWaySearch(pattern, text, length, pos + 16);
+    }
+    return twoWaySearch(pattern, text, length, pos);
+}
+
+CSTRING_AVX2 static int filterSearchAvx2(const SearchPattern& pattern, const char text[], int length, int start) {
+    int m = pattern.length;
+    if (m < 2) return twoWaySearch(pattern, text, length, start);
+    const __m256i first = _mm256_set1_epi8(pattern.bytes[0]);
+    const __m256i last = _mm256_set1_epi8(pattern.bytes[m - 1]);
+    long long falseCandidates = 0;
+    int pos = start;
+    for (; pos + 32 + m - 1 <= length; pos += 32) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)(text + pos));
+        __m256i b = _mm256_loadu_si256((const __m256i*)(text + pos + m - 1));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, first),
+                                                                        _mm256_cmpeq_epi8(b, last)));
+        while (mask != 0) {
+            int candidate = pos + lowestBit(mask);
+            if (verifyCandidate(pattern, text + candidate)) return candidate;
+            falseCandidates++;
+            mask &= mask - 1;
+        }
+        if (falseCandidates * 8 > pos - start + FILTER_SLACK) return twoWaySearch(pattern, text, length, pos + 32);
+    }
+    return twoWaySearch(pattern, text, length, pos);
+}
+// Range tests bias v so that first maps to -128, then use one signed compare
+static inline __m128i rangeSse2(__m128i v, char first, char last) {
+    __m128i biased = _mm_add_epi8(v, _mm_set1_epi8((char)(0x80 - first)));
+    return _mm_cmpgt_epi8(_mm_set1_epi8((char)(0x80 + last - first + 1)), biased);
+}
+
+static void changeCaseSse2(char str[], int length, char first, char last) {
+    const __m128i flip = _mm_set1_epi8(0x20);
+    int i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(str + i));
+        v = _mm_xor_si128(v, _mm_and_si128(rangeSse2(v, first, last), flip));
+        _mm_storeu_si128((__m128i*)(str + i), v);
+    }
+    changeCaseWord(str + i, length - i, first, last);
+}
+
+// Match masks are 0xFF (-1), so subtracting them counts matches per byte
+// lane; lanes are summed with SAD before they can wrap at 255
+static void countLettersSse2(const char str[], int length, int& letters, int& vowels) {
+    const __m128i lowerBit = _mm_set1_epi8(0x20);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i letterSums = zero, vowelSums = zero;
+    int i = 0;
+    while (i + 16 <= length) {
+        __m128i letterLanes = zero, vowelLanes = zero;
+        for (int step = 0; step < 255 && i + 16 <= length; step++, i += 16) {
+            __m128i lower = _mm_or_si128(_mm_loadu_si128((const __m128i*)(str + i)), lowerBit);
+            __m128i letter = rangeSse2(lower, 'a', 'z');
+            __m128i vowel = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(lower, _mm_set1_epi8('a')),
+                                                      _mm_cmpeq_epi8(lower, _mm_set1_epi8('e'))),
+                                         _mm_or_si128(_mm_cmpeq_epi8(lower, _mm_set1_epi8('i')),
+                                                      _mm_or_si128(_mm_cmpeq_epi8(lower, _mm_set1_epi8('o')),
+                                                                   _mm_cmpeq_epi8(lower, _mm_set1_epi8('u')))));
+            letterLanes = _mm_sub_epi8(letterLanes, letter);
+            vowelLanes = _mm_sub_epi8(vowelLanes, vowel);
+        }
+        letterSums = _mm_add_epi64(letterSums, _mm_sad_epu8(letterLanes, zero));
+        vowelSums = _mm_add_epi64(vowelSums, _mm_sad_epu8(vowelLanes, zero));
+    }
+    letters = _mm_cvtsi128_si32(letterSums) + _mm_cvtsi128_si32(_mm_unpackhi_epi64(letterSums, letterSums));
+    vowels = _mm_cvtsi128_si32(vowelSums) + _mm_cvtsi128_si32(_mm_unpackhi_epi64(vowelSums, vowelSums));
+    int restLetters, restVowels;
+    countLettersScalar(str + i, length - i, restLetters, restVowels);
+    letters += restLetters;
+    vowels += restVowels;
+}
+
+static inline __m128i classSse2(__m128i v, int classes) {
+    __m128i mask = _mm_setzero_si128();
+    if (classes & CLASS_ALPHA) mask = rangeSse2(_mm_or_si128(v, _mm_set1_epi8(0x20)), 'a', 'z');
+    if (classes & CLASS_DIGIT) mask = _mm_or_si128(mask, rangeSse2(v, '0', '9'));
+    return mask;
+}
+
+static int classSpanSse2(const char str[], int length, int classes) {
+    int i = 0;
+    for (; i + 16 <= length; i += 16) {
+        unsigned mask = (unsigned)_mm_movemask_epi8(classSse2(_mm_loadu_si128((const __m128i*)(str + i)), classes));
+        if (mask != 0xFFFF) return i + lowestBit(~mask);
+    }
+    return i + classSpanScalar(str + i, length - i, classes);
+}
+
+CSTRING_AVX2 static inline __m256i rangeAvx2(__m256i v, char first, char last) {
+    __m256i biased = _mm256_add_epi8(v, _mm256_set1_epi8((char)(0x80 - first)));
+    return _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(0x80 + last - first + 1)), biased);
+}
+
+CSTRING_AVX2 static void changeCaseAvx2(char str[], int length, char first, char last) {
+    const __m256i flip = _mm256_set1_epi8(0x20);
+    int i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(str + i));
+        v = _mm256_xor_si256(v, _mm256_and_si256(rangeAvx2(v, first, last), flip));
+        _mm256_storeu_si256((__m256i*)(str + i), v);
+    }
+    changeCaseSse2(str + i, length - i, first, last);
+}
+
+CSTRING_AVX2 static void countLettersAvx2(const char str[], int length, int& letters, int& vowels) {
+    const __m256i lowerBit = _mm256_set1_epi8(0x20);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i letterSums = zero, vowelSums = zero;
+    int i = 0;
+    while (i + 32 <= length) {
+        __m256i letterLanes = zero, vowelLanes = zero;
+        for (int step = 0; step < 255 && i + 32 <= length; step++, i += 32) {
+            __m256i lower = _mm256_or_si256(_mm256_loadu_si256((const __m256i*)(str + i)), lowerBit);
+            __m256i letter = rangeAvx2(lower, 'a', 'z');
+            __m256i vowel = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(lower, _mm256_set1_epi8('a')),
+                                _mm256_cmpeq_epi8(lower, _mm256_set1_epi8('e'))),
+                _mm256_or_si256(_mm256_cmpeq_epi8(lower, _mm256_set1_epi8('i')),
+                                _mm256_or_si256(_mm256_cmpeq_epi8(lower, _mm256_set1_epi8('o')),
+                                                _mm256_cmpeq_epi8(lower, _mm256_set1_epi8('u')))));
+            letterLanes = _mm256_sub_epi8(letterLanes, letter);
+            vowelLanes = _mm256_sub_epi8(vowelLanes, vowel);
+        }
+        letterSums = _mm256_add_epi64(letterSums, _mm256_sad_epu8(letterLanes, zero));
+        vowelSums = _mm256_add_epi64(vowelSums, _mm256_sad_epu8(vowelLanes, zero));
+    }
+    alignas(32) long long lanes[8];
+    _mm256_store_si256((__m256i*)lanes, letterSums);
+    _mm256_store_si256((__m256i*)(lanes + 4), vowelSums);
+    int restLetters, restVowels;
+    countLettersSse2(str + i, length - i, restLetters, restVowels);
+    letters = (int)(lanes[0] + lanes[1] + lanes[2] + lanes[3]) + restLetters;
+    vowels = (int)(lanes[4] + lanes[5] + lanes[6] + lanes[7]) + restVowels;
+}
+
+CSTRING_AVX2 static int classSpanAvx2(const char str[], int length, int classes) {
+    __m256i lowerBit = _mm256_set1_epi8(0x20);
+    int i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(str + i));
+        __m256i mask = _mm256_setzero_si256();
+        if (classes & CLASS_ALPHA) mask = rangeAvx2(_mm256_or_si256(v, lowerBit), 'a', 'z');
+        if (classes & CLASS_DIGIT) mask = _mm256_or_si256(mask, rangeAvx2(v, '0', '9'));
+        unsigned bits = (unsigned)_mm256_movemask_epi8(mask);
+        if (bits != 0xFFFFFFFFu) return i + lowestBit(~bits);
+    }
+    return i + classSpanSse2(str + i, length - i, classes);
+}
+
+// Byte-set search for small sets: one compare per set byte, OR-ed together
+static const int MAX_VECTOR_SET = 8;
+
+static int findAnySse2(const char* data, int length, const unsigned char* set, int setSize) {
+    __m128i needles[MAX_VECTOR_SET];
+    for (int s = 0; s < setSize; s++) needles[s] = _mm_set1_epi8((char)set[s]);
+    int i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(data + i));
+        __m128i hits = _mm_cmpeq_epi8(v, needles[0]);
+        for (int s = 1; s < setSize; s++) hits = _mm_or_si128(hits, _mm_cmpeq_epi8(v, needles[s]));
+        unsigned mask = (unsigned)_mm_movemask_epi8(hits);
+        if (mask != 0) return i + lowestBit(mask);
+    }
+    for (; i < length; i++) {
+        for (int s = 0; s < setSize; s++) {
+            if ((unsigned char)data[i] == set[s]) return i;
+        }
+    }
+    return -1;
+}
+
+CSTRING_AVX2 static int findAnyAvx2(const char* data, int length, const unsigned char* set, int setSize) {
+    __m256i needles[MAX_VECTOR_SET];
+    for (int s = 0; s < setSize; s++) needles[s] = _mm256_set1_epi8((char)set[s]);
+    int i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(data + i));
+        __m256i hits = _mm256_cmpeq_epi8(v, needles[0]);
+        for (int s = 1; s < setSize; s++) hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(v, needles[s]));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(hits);
+        if (mask != 0) return i + lowestBit(mask);
+    }
+    int rest = findAnySse2(data + i, length - i, set, setSize);
+    return rest < 0 ? -1 : i + rest;
+}
+// Compaction at SSE2: a 16-byte keep mask from OR-ed compares (sets of up to 8
+// bytes), whole-block fast paths, and branchless stores for mixed blocks
+static int compactSse2(char dest[], const char src[], int length, const ByteSet& set) {
+    if (set.count > MAX_VECTOR_SET) return compactBranchless(dest, src, length, set);
+    __m128i needles[MAX_VECTOR_SET];
+    for (int s = 0; s < set.count; s++) needles[s] = _mm_set1_epi8((char)set.members[s]);
+    int i = 0, j = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i hits = _mm_cmpeq_epi8(v, needles[0]);
+        for (int s = 1; s < set.count; s++) hits = _mm_or_si128(hits, _mm_cmpeq_epi8(v, needles[s]));
+        unsigned keep = ~(unsigned)_mm_movemask_epi8(hits) & 0xFFFF;
+        if (keep == 0xFFFF) {
+            _mm_storeu_si128((__m128i*)(dest + j), v);  // dest + j <= src + i: only loaded bytes are overwritten
+            j += 16;
+        } else if (keep != 0) {
+            alignas(16) char block[16];
+            _mm_store_si128((__m128i*)block, v);
+            for (int k = 0; k < 16; k++) {
+                dest[j] = block[k];
+                j += (keep >> k) & 1;
+            }
+        }
+    }
+    return j + compactBranchless(dest + j, src + i, length - i, set);
+}
+
+// Shuffle controls that gather the kept bytes of an 8-byte group to its front
+struct CompactTable {
+    uint64_t shuffle[256];
+    unsigned char count[256];
+};
+
+static CompactTable buildCompactTable() {
+    CompactTable table;
+    for (int mask = 0; mask < 256; mask++) {
+        uint64_t control = 0;
+        int count = 0;
+        for (int bit = 0; bit < 8; bit++) {
+            if (mask & (1 << bit)) control |= (uint64_t)bit << (8 * count++);
+        }
+        table.shuffle[mask] = control;
+        table.count[mask] = (unsigned char)count;
+    }
+    return table;
+}
+
+static const CompactTable& compactTable() {
+    static const CompactTable table = buildCompactTable();
+    return table;
+}
+
+// Any byte set in a few instructions: the low nibble selects a row of member
+// high nibbles (pshufb into lowRows/highRows), the high nibble selects a bit
+// of that row
+CSTRING_AVX2 static inline __m256i memberMaskAvx2(__m256i v, __m256i lowRows, __m256i highRows, __m256i bitForNibble) {
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    __m256i lo = _mm256_and_si256(v, nibble);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble);
+    __m256i upper = _mm256_cmpgt_epi8(_mm256_setzero_si256(), v);  // Byte >= 0x80
+    __m256i rows = _mm256_blendv_epi8(_mm256_shuffle_epi8(lowRows, lo), _mm256_shuffle_epi8(highRows, lo), upper);
+    __m256i bit = _mm256_shuffle_epi8(bitForNibble, hi);
+    return _mm256_cmpeq_epi8(_mm256_and_si256(rows, bit), bit);
+}
+
+// Each 8-byte group of a mixed block is packed with one pshufb and stored
+// whole; the write position advances by the group's kept count
+CSTRING_AVX2 static int compactAvx2(char dest[], const char src[], int length, const ByteSet& set) {
+    const CompactTable& table = compactTable();
+    __m256i lowRows = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)set.lowRows));
+    __m256i highRows = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)set.highRows));
+    __m256i bitForNibble = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                                            1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    int i = 0, j = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+        unsigned keep = ~(unsigned)_mm256_movemask_epi8(memberMaskAvx2(v, lowRows, highRows, bitForNibble));
+        if (keep == 0xFFFFFFFFu) {
+            _mm256_storeu_si256((__m256i*)(dest + j), v);
+            j += 32;
+            continue;
+        }
+        if (keep == 0) continue;
+        for (int half = 0; half < 2; half++) {
+            __m128i lane = half == 0 ? _mm256_castsi256_si128(v) : _mm256_extracti128_si256(v, 1);
+            unsigned low = (keep >> (16 * half)) & 0xFF, high = (keep >> (16 * half + 8)) & 0xFF;
+            __m128i control = _mm_set_epi64x((long long)(table.shuffle[high] + 0x0808080808080808ULL),
+                                             (long long)table.shuffle[low]);
+            __m128i packed = _mm_shuffle_epi8(lane, control);
+            _mm_storel_epi64((__m128i*)(dest + j), packed);
+            j += table.count[low];
+            _mm_storel_epi64((__m128i*)(dest + j), _mm_unpackhi_epi64(packed, packed));
+            j += table.count[high];
+        }
+    }
+    return j + compactBranchless(dest + j, src + i, length - i, set);
+}
+#endif
+
+// ==================== RUNTIME DISPATCH ====================
+
+struct StringKernels {
+    int level;
+    int (*length)(const char[]);
+    void (*copy)(char[], const char[]);
+    int (*compare)(const char[], const char[]);
+    int (*findChar)(const char[], char);
+    int (*search)(const SearchPattern&, const char[], int, int);
+    void (*changeCase)(char[], int, char, char);
+    void (*countLetters)(const char[], int, int&, int&);
+    int (*classSpan)(const char[], int, int);
+    int (*compact)(char[], const char[], int, const ByteSet&);
+};
+
+// Highest level this CPU can run
+static int supportedSimdLevel() {
+#ifdef CSTRING_X86_SIMD
+    if (__builtin_cpu_supports("avx2")) return SIMD_AVX2;
+    return SIMD_SSE2;
+#else
+    return SIMD_WORD;
+#endif
+}
+
+static StringKernels kernelsForLevel(int level) {
+    StringKernels k = {SIMD_SCALAR, lengthScalar, copyScalar, compareScalar, findCharScalar, twoWaySearch,
+                       changeCaseScalar, countLettersScalar, classSpanScalar, compactScalar};
+    if (level >= SIMD_WORD) {
+        k = {SIMD_WORD, lengthWord, copyWord, compareWord, findCharWord, twoWaySearch,
+             changeCaseWord, countLettersWord, classSpanWord, compactWord};
+    }
+#ifdef CSTRING_X86_SIMD
+    if (level >= SIMD_SSE2) {
+        k = {SIMD_SSE2, lengthSse2, copySse2, compareSse2, findCharSse2, filterSearchSse2,
+             changeCaseSse2, countLettersSse2, classSpanSse2, compactSse2};
+    }
+    if (level >= SIMD_AVX2) {
+        k = {SIMD_AVX2, lengthAvx2, copyAvx2, compareAvx2, findCharAvx2, filterSearchAvx2,
+             changeCaseAvx2, countLettersAvx2, classSpanAvx2, compactAvx2};
+    }
+#endif
+    return k;
+}
+
+// Resolved on first use, so calls from other static initializers are safe
+static StringKernels& activeKernels() {
+    static StringKernels kernels = kernelsForLevel(supportedSimdLevel());
+    return kernels;
+}
+
+int stringSimdLevel() {
+    return activeKernels().level;
+}
+
+int setStringSimdLevel(int level) {
+    int supported = supportedSimdLevel();
+    if (level > supported) level = supported;
+    if (level < SIMD_SCALAR) level = SIMD_SCALAR;
+    activeKernels() = kernelsForLevel(level);
+    return activeKernels().level;
+}
+
+// ==================== BASIC STRING OPERATIONS ====================
+
+int stringLength(const char str[]) {
+    return activeKernels().length(str);
+}
+
+void stringCopy(char dest[], const char src[]) {
+    activeKernels().copy(dest, src);
+}
+
+void stringConcat(char dest[], const char src[]) {
+    int destLen = stringLength(dest);  // Find end of dest
+    stringCopy(dest + destLen, src);   // Append src to dest
+}
+
+int stringCompare(const char str1[], const char str2[]) {
+    return activeKernels().compare(str1, str2);
+}
+
+// ==================== STRING SEARCH OPERATIONS ====================
+
+int findChar(const char str[], char ch) {
+    if (ch == '\0') return -1;  // The terminator is never reported
+    return activeKernels().findChar(str, ch);
+}
+
+int findSubstring(const char str[], const char substr[]) {
+    int subLen = stringLength(substr);
+    if (subLen == 0) return 0;  // Empty substring found at start
+    if (subLen == 1) return findChar(str, substr[0]);
+    int strLen = stringLength(str);
+    if (subLen > strLen) return -1;  // Substring too long
+
+    SearchPattern pattern;
+    preparePattern(pattern, substr, subLen);  // Borrows substr, nothing to free
+    return activeKernels().search(pattern, str, strLen, 0);
+}
+
+// ==================== COMPILED SUBSTRING SEARCH ====================
+
+int compilePattern(SearchPattern& pattern, const char str[]) {
+    int length = stringLength(str);
+    char* bytes = new char[length + 1];
+    stringCopy(bytes, str);
+    preparePattern(pattern, bytes, length);
+    return 1;
+}
+
+void freePattern(SearchPattern& pattern) {
+    delete[] pattern.bytes;
+    pattern.bytes = nullptr;
+    pattern.length = 0;
+}
+
+int findPattern(const SearchPattern& pattern, const char text[]) {
+    if (pattern.length == 0) return 0;
+    if (pattern.length == 1) return findChar(text, pattern.bytes[0]);
+    return findPatternIn(pattern, text, stringLength(text), 0);
+}
+
+int findPatternIn(const SearchPattern& pattern, const char text[], int length, int start) {
+    if (start < 0) start = 0;
+    if (start > length) return -1;
+    if (pattern.length == 0) return start;
+    if (pattern.length > length - start) return -1;
+    if (pattern.length == 1) {
+        const void* hit = memchr(text + start, pattern.bytes[0], length - start);
+        return hit ? (int)((const char*)hit - text) : -1;
+    }
+    return activeKernels().search(pattern, text, length, start);
+}
+
+// ==================== STRING MANIPULATION OPERATIONS ====================
+
+void reverseString(char str[]) {
+    int len = stringLength(str);
+    for (int i = 0; i < len / 2; i++) {  // Swap from both ends
+        char temp = str[i];
+        str[i] = str[len - 1 - i];
+        str[len - 1 - i] = temp;
+    }
+}
+
+void toUpperCase(char str[]) {
+    toUpperCase(str, stringLength(str));
+}
+
+void toLowerCase(char str[]) {
+    toLowerCase(str, stringLength(str));
+}
+
+// ==================== STRING ANALYSIS OPERATIONS ====================
+
+int countVowels(const char str[]) {
+    return countVowels(makeView(str));
+}
+
+int countConsonants(const char str[]) {
+    return countConsonants(makeView(str));
+}
+
+int countWords(const char str[]) {
+    int count = 0;
+    int inWord = 0;  // Track if currently in a word
+    
+    for (int i = 0; str[i] != '\0'; i++) {
+        if (str[i] != ' ' && str[i] != '\t' && str[i] != '\n') {  // Non-whitespace
+            if (!inWord) {
+                count++;  // Start of a new word
+                inWord = 1;
+            }
+        } else {
+            inWord = 0;  // End of word
+        }
+    }
+    return count;
+}
+
+int isPalindrome(const char str[]) {
+    int len = stringLength(str);
+    for (int i = 0; i < len / 2; i++) {  // Compare from both ends
+        if (str[i] != str[len - 1 - i]) {
+            return 0;  // Not a palindrome
+        }
+    }
+    return 1;  // Is a palindrome
+}
+
+// ==================== STRING UTILITY OPERATIONS ====================
+
+void removeSpaces(char str[]) {
+    removeSpaces(str, stringLength(str));
+}
+
+void trimString(char str[]) {
+    int start = 0;
+    int len = stringLength(str);
+    
+    while (str[start] == ' ' || str[start] == '\t') {  // Skip leading whitespace
+        start++;
+    }
+    
+    int end = len - 1;
+    while (end >= start && (str[end] == ' ' || str[end] == '\t')) {  // Skip trailing whitespace
+        end--;
+    }
+    
+    int i = 0;
+    for (int j = start; j <= end; j++) {  // Copy trimmed string
+        str[i] = str[j];
+        i++;
+    }
+    str[i] = '\0';  // Terminate string
+}
+
+// ==================== ADVANCED STRING SEARCH ====================
+
+int countOccurrences(const char str[], char ch) {
+    int count = 0;
+    for (int i = 0; str[i] != '\0'; i++) {
+        if (str[i] == ch) {  // Match found
+            count++;
+        }
+    }
+    return count;
+}
+
+int stringContains(const char str[], const char substr[]) {
+    return findSubstring(str, substr) != -1;  // Returns 1 if found, 0 otherwise
+}
+
+// ==================== STRING MODIFICATION ====================
+
+void stringNCopy(char dest[], const char src[], int n) {
+    int i = 0;
+    while (i < n && src[i] != '\0') {  // Copy up to n characters
+        dest[i] = src[i];
+        i++;
+    }
+    dest[i] = '\0';  // Null terminate
+}
+
+void stringNConcat(char dest[], const char src[], int n) {
+    int destLen = stringLength(dest);  // Find end of dest
+    int i = 0;
+    while (i < n && src[i] != '\0') {  // Append up to n characters
+        dest[destLen + i] = src[i];
+        i++;
+    }
+    dest[destLen + i] = '\0';  // Null terminate
+}
+
+void replaceChar(char str[], char oldChar, char newChar) {
+    for (int i = 0; str[i] != '\0'; i++) {
+        if (str[i] == oldChar) {  // Found character to replace
+            str[i] = newChar;
+        }
+    }
+}
+
+void insertString(char str[], const char insert[], int pos) {
+    int strLen = stringLength(str);
+    int insertLen = stringLength(insert);
+    
+    if (pos < 0 || pos > strLen) return;  // Validate position
+    
+    for (int i = strLen; i >= pos; i--) {  // Shift characters right
+        str[i + insertLen] = str[i];
+    }
+    
+    for (int i = 0; i < insertLen; i++) {  // Insert new string
+        str[pos + i] = insert[i];
+    }
+}
+
+// ==================== STRING EXTRACTION ====================
+
+void substring(const char str[], int start, int length, char result[]) {
+    int strLen = stringLength(str);
+    
+    if (start < 0 || start >= strLen || length <= 0) {  // Validate parameters
+        result[0] = '\0';
+        return;
+    }
+    
+    int i = 0;
+    while (i < length && str[start + i] != '\0') {  // Extract substring
+        result[i] = str[start + i];
+        i++;
+    }
+    result[i] = '\0';  // Null terminate
+}
+
+// ==================== STRING VALIDATION ====================
+
+int isAlpha(const char str[]) {
+    return isAlpha(makeView(str));
+}
+
+int isDigit(const char str[]) {
+    return isDigit(makeView(str));
+}
+
+int isAlphaNumeric(const char str[]) {
+    return isAlphaNumeric(makeView(str));
+}
+
+// ==================== CHARACTER TYPE CHECKING ====================
+
+int isCharAlpha(char ch) {
+    return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z');  // Check if letter
+}
+
+int isCharDigit(char ch) {
+    return ch >= '0' && ch <= '9';  // Check if digit
+}
+
+int isCharWhitespace(char ch) {
+    return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r';  // Check if whitespace
+}
+
+// ==================== STRING CONVERSION ====================
+
+void intToString(int num, char str[]) {
+    formatInt64(num, str);  // Digits are written in order; no reversal
+}
+
+int stringToInt(const char str[]) {
+    int result = 0;
+    int sign = 1;
+    int i = 0;
+    
+    while (str[i] == ' ' || str[i] == '\t') {  // Skip whitespace
+        i++;
+    }
+    
+    if (str[i] == '-') {  // Handle sign
+        sign = -1;
+        i++;
+    } else if (str[i] == '+') {
+        i++;
+    }
+    
+    while (str[i] >= '0' && str[i] <= '9') {  // Convert digits
         result = result * 10 + (str[i] - '0');
         i++;
     }
@@ -375,6 +1296,539 @@ int stringToInt(const char str[]) {
     return result * sign;  // Apply sign
 }
 
+// ==================== NUMBER CONVERSION ====================
+
+// "00" "01" ... "99": two digits per lookup
+static const char DIGIT_PAIRS[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static const uint64_t POW10[20] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+    1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+    100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+    1000000000000000000ULL, 10000000000000000000ULL,
+};
+
+static inline int countDigits(uint64_t value) {
+    int digits = 1;
+    while (digits < 20 && value >= POW10[digits]) digits++;
+    return digits;
+}
+
+// Writes exactly `digits` digits of value ending at out + digits, two at a time
+static inline void writeDigits(char out[], uint64_t value, int digits) {
+    int pos = digits;
+    while (pos >= 2) {
+        pos -= 2;
+        memcpy(out + pos, DIGIT_PAIRS + 2 * (value % 100), 2);
+        value /= 100;
+    }
+    if (pos == 1) out[0] = (char)('0' + value);
+}
+
+int formatUint64(unsigned long long value, char out[]) {
+    int digits = countDigits(value);
+    writeDigits(out, value, digits);
+    out[digits] = '\0';
+    return digits;
+}
+
+int formatInt64(long long value, char out[]) {
+    if (value >= 0) return formatUint64((unsigned long long)value, out);
+    out[0] = '-';
+    // Negate as unsigned so LLONG_MIN is handled
+    return 1 + formatUint64(0ULL - (unsigned long long)value, out + 1);
+}
+
+// SWAR digit parsing reads eight bytes as one little-endian word
+static inline int littleEndianHost() {
+    const uint16_t one = 1;
+    unsigned char first;
+    memcpy(&first, &one, 1);
+    return first;
+}
+
+// True if all eight bytes are '0'..'9'
+static inline int isEightDigits(uint64_t v) {
+    return ((v & 0xF0F0F0F0F0F0F0F0ULL) | (((v + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+           0x3333333333333333ULL;
+}
+
+// Combines digit pairs, then pairs of pairs, then the two halves: three
+// multiplications for eight digits
+static inline uint32_t parseEightDigits(uint64_t v) {
+    v -= 0x3030303030303030ULL;
+    v = v * 10 + (v >> 8);
+    v = (((v & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+         (((v >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+    return (uint32_t)v;
+}
+
+// Accumulates the digits at p into value; digits past the 64-bit range set
+// overflow but are still consumed. Returns the number of digits read
+static int parseDigits(const char* p, int length, uint64_t& value, int& overflow) {
+    const uint64_t EIGHT_DIGIT_LIMIT = (UINT64_MAX - 99999999ULL) / 100000000ULL;
+    int i = 0;
+    value = 0;
+    overflow = 0;
+    if (littleEndianHost()) {
+        while (i + 8 <= length && value <= EIGHT_DIGIT_LIMIT) {
+            uint64_t word = loadWord(p + i);
+            if (!isEightDigits(word)) break;
+            value = value * 100000000ULL + parseEightDigits(word);
+            i += 8;
+        }
+    }
+    for (; i < length && p[i] >= '0' && p[i] <= '9'; i++) {
+        unsigned digit = (unsigned)(p[i] - '0');
+        if (overflow || value > (UINT64_MAX - digit) / 10) {
+            overflow = 1;
+        } else {
+            value = value * 10 + digit;
+        }
+    }
+    return i;
+}
+
+NumberResult parseUint64(StringView text, unsigned long long& value) {
+    NumberResult result = {NUMBER_INVALID, 0};
+    value = 0;
+    int i = (text.length > 0 && text.data[0] == '+') ? 1 : 0;
+    uint64_t magnitude;
+    int overflow;
+    int digits = parseDigits(text.data + i, text.length - i, magnitude, overflow);
+    if (digits == 0) return result;
+    result.consumed = i + digits;
+    result.status = overflow ? NUMBER_OVERFLOW : NUMBER_OK;
+    value = overflow ? UINT64_MAX : magnitude;
+    return result;
+}
+
+NumberResult parseInt64(StringView text, long long& value) {
+    NumberResult result = {NUMBER_INVALID, 0};
+    value = 0;
+    int i = 0;
+    int negative = 0;
+    if (text.length > 0 && (text.data[0] == '-' || text.data[0] == '+')) {
+        negative = text.data[0] == '-';
+        i = 1;
+    }
+    uint64_t magnitude;
+    int overflow;
+    int digits = parseDigits(text.data + i, text.length - i, magnitude, overflow);
+    if (digits == 0) return result;
+    result.consumed = i + digits;
+    uint64_t limit = negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX;
+    if (overflow || magnitude > limit) {
+        result.status = NUMBER_OVERFLOW;
+        value = negative ? INT64_MIN : INT64_MAX;
+        return result;
+    }
+    result.status = NUMBER_OK;
+    value = negative ? (long long)(0ULL - magnitude) : (long long)magnitude;
+    return result;
+}
+
+// ---- Shortest round-trip double formatting (Grisu3) ----
+// The double's rounding interval is scaled by a cached power of ten into a
+// 64-bit fixed-point range, widened by the one-unit error of that scaling, and
+// the shortest digit string inside it is generated. The digits are accepted
+// only if they are provably inside the exact interval and closest to the value;
+// otherwise (about 0.5% of inputs, mostly short decimals sitting on an interval
+// edge) the correctly rounded forms from snprintf are tried, shortest first.
+// Either way the output is the shortest string that reads back as the double.
+
+struct DiyFp {
+    uint64_t f;  // Significand
+    int e;       // Binary exponent: value = f * 2^e
+};
+
+// Normalized 10^k for k = -348, -340, ..., 340
+static const uint64_t CACHED_POWER_SIGNIFICANDS[87] = {
+    0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL, 0xcf42894a5dce35eaULL,
+    0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL, 0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL,
+    0xbe5691ef416bd60cULL, 0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+    0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL, 0xc21094364dfb5637ULL,
+    0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL, 0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL,
+    0xb23867fb2a35b28eULL, 0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+    0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL, 0xb5b5ada8aaff80b8ULL,
+    0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL, 0x964e858c91ba2655ULL, 0xdff9772470297ebdULL,
+    0xa6dfbd9fb8e5b88fULL, 0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+    0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL, 0xaa242499697392d3ULL,
+    0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL, 0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL,
+    0x9c40000000000000ULL, 0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+    0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL, 0x9f4f2726179a2245ULL,
+    0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL, 0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL,
+    0x924d692ca61be758ULL, 0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+    0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL, 0x952ab45cfa97a0b3ULL,
+    0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL, 0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL,
+    0x88fcf317f22241e2ULL, 0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+    0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL, 0x8bab8eefb6409c1aULL,
+    0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL, 0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL,
+    0x80444b5e7aa7cf85ULL, 0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+    0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL,
+};
+
+static const int16_t CACHED_POWER_EXPONENTS[87] = {
+    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980,
+    -954, -927, -901, -874, -847, -821, -794, -768, -741, -715,
+    -688, -661, -635, -608, -582, -555, -529, -502, -475, -449,
+    -422, -396, -369, -343, -316, -289, -263, -236, -210, -183,
+    -157, -130, -103, -77, -50, -24, 3, 30, 56, 83,
+    109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+    375, 402, 428, 455, 481, 508, 534, 561, 588, 614,
+    641, 667, 694, 720, 747, 774, 800, 827, 853, 880,
+    907, 933, 960, 986, 1013, 1039, 1066,
+};
+
+// Rounded high 64 bits of the 128-bit product
+static DiyFp diyMultiply(DiyFp x, DiyFp y) {
+    const uint64_t LOW = 0xFFFFFFFFULL;
+    uint64_t a = x.f >> 32, b = x.f & LOW, c = y.f >> 32, d = y.f & LOW;
+    uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+    uint64_t middle = (bd >> 32) + (ad & LOW) + (bc & LOW) + (1ULL << 31);
+    DiyFp product = {ac + (ad >> 32) + (bc >> 32) + (middle >> 32), x.e + y.e + 64};
+    return product;
+}
+
+static DiyFp diyNormalize(DiyFp x) {
+    while ((x.f & (1ULL << 63)) == 0) {
+        x.f <<= 1;
+        x.e--;
+    }
+    return x;
+}
+
+static DiyFp diyFromDouble(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    uint64_t significand = bits & ((1ULL << 52) - 1);
+    int biased = (int)((bits >> 52) & 0x7FF);
+    DiyFp result;
+    if (biased != 0) {
+        result.f = significand | (1ULL << 52);
+        result.e = biased - 1075;
+    } else {
+        result.f = significand;  // Subnormal
+        result.e = -1074;
+    }
+    return result;
+}
+
+// Cached power c = 10^-k such that the scaled upper boundary has a binary
+// exponent in [-60, -32]
+static DiyFp cachedPower(int e, int& k) {
+    double dk = (-61 - e) * 0.30102999566398114 + 347;
+    int ik = (int)dk;
+    if (dk - ik > 0.0) ik++;
+    int index = (ik >> 3) + 1;
+    k = -(-348 + index * 8);
+    DiyFp power = {CACHED_POWER_SIGNIFICANDS[index], CACHED_POWER_EXPONENTS[index]};
+    return power;
+}
+
+// Distance between two remainders measured from the top of the interval
+static inline uint64_t remainderGap(uint64_t a, uint64_t b) {
+    return a > b ? a - b : b - a;
+}
+
+// Moves the last digit toward w while it stays in the interval, then checks
+// the choice against the scaling error: every remainder and distance is known
+// to within `unit`. Returns false unless the digits lie at least 2 units inside
+// the widened interval and both neighbouring candidates are clearly farther
+// from w. rest = high - digits, distance = high - w, all scaled by tenKappa's base
+static bool grisuRoundWeed(char buffer[], int length, uint64_t delta, uint64_t rest,
+                           uint64_t tenKappa, uint64_t distance, uint64_t unit) {
+    while (rest < distance && delta - rest >= tenKappa &&
+           (rest + tenKappa < distance || distance - rest > rest + tenKappa - distance)) {
+        buffer[length - 1]--;
+        rest += tenKappa;
+    }
+    if (rest < 2 * unit || delta - rest < 2 * unit) return false;
+    uint64_t gap = remainderGap(rest, distance);
+    if (delta - rest >= tenKappa && remainderGap(rest + tenKappa, distance) < gap + 2 * unit) return false;
+    if (rest >= tenKappa && remainderGap(rest - tenKappa, distance) < gap + 2 * unit) return false;
+    return true;
+}
+
+// Emits the digits of high (the upper boundary) until the remainder falls
+// within delta of it; k receives the decimal exponent of the last digit.
+// The length is always returned; exact reports whether the digits passed
+// grisuRoundWeed
+static int generateDigits(DiyFp w, DiyFp high, uint64_t delta, char buffer[], int& k, bool& exact) {
+    DiyFp one = {1ULL << -high.e, high.e};
+    uint64_t distance = high.f - w.f;
+    uint32_t integral = (uint32_t)(high.f >> -one.e);
+    uint64_t fraction = high.f & (one.f - 1);
+    int kappa = countDigits(integral);
+    int length = 0;
+    while (kappa > 0) {
+        uint32_t divisor = (uint32_t)POW10[kappa - 1];
+        uint32_t digit = integral / divisor;
+        integral %= divisor;
+        if (digit != 0 || length != 0) buffer[length++] = (char)('0' + digit);
+        kappa--;
+        uint64_t rest = ((uint64_t)integral << -one.e) + fraction;
+        if (rest <= delta) {
+            k += kappa;
+            exact = grisuRoundWeed(buffer, length, delta, rest, POW10[kappa] << -one.e, distance, 1);
+            return length;
+        }
+    }
+    uint64_t unit = 1;
+    for (;;) {
+        fraction *= 10;
+        delta *= 10;
+        distance *= 10;
+        unit *= 10;
+        uint32_t digit = (uint32_t)(fraction >> -one.e);
+        if (digit != 0 || length != 0) buffer[length++] = (char)('0' + digit);
+        fraction &= one.f - 1;
+        kappa--;
+        if (fraction < delta) {
+            k += kappa;
+            exact = grisuRoundWeed(buffer, length, delta, fraction, one.f, distance, unit);
+            return length;
+        }
+    }
+}
+
+// Shortest digits of a positive finite value; value = digits * 10^k. exact is
+// false when the digits could not be verified (see grisuRoundWeed); the length
+// is then a lower bound on the shortest length
+static int grisu3(double value, char digits[], int& k, bool& exact) {
+    DiyFp v = diyFromDouble(value);
+    DiyFp upper = {(v.f << 1) + 1, v.e - 1};
+    upper = diyNormalize(upper);
+    // The interval is asymmetric at powers of two, where the gap below halves
+    DiyFp lower = (v.f == (1ULL << 52)) ? DiyFp{(v.f << 2) - 1, v.e - 2} : DiyFp{(v.f << 1) - 1, v.e - 1};
+    lower.f <<= lower.e - upper.e;
+    lower.e = upper.e;
+
+    DiyFp power = cachedPower(upper.e, k);
+    DiyFp w = diyMultiply(diyNormalize(v), power);
+    DiyFp high = diyMultiply(upper, power);
+    DiyFp low = diyMultiply(lower, power);
+    low.f--;  // Widen by the product error so no candidate is missed
+    high.f++;
+    return generateDigits(w, high, high.f - low.f, digits, k, exact);
+}
+
+// Slow path: the correctly rounded minLength-, (minLength+1)-, ... digit forms
+// from snprintf, until one reads back as value (17 digits always do)
+static int exactShortestDigits(double value, int minLength, char digits[], int& k) {
+    char text[40];
+    int length = 0;
+    for (int precision = minLength < 1 ? 1 : minLength; precision <= 17; precision++) {
+        snprintf(text, sizeof(text), "%.*e", precision - 1, value);
+        length = 0;
+        int i = 0;
+        for (; text[i] != 'e'; i++) {  // Skips the (locale-specific) decimal point
+            if (text[i] >= '0' && text[i] <= '9') digits[length++] = text[i];
+        }
+        k = atoi(text + i + 1) - (precision - 1);
+        while (length > 1 && digits[length - 1] == '0') {
+            length--;
+            k++;
+        }
+        memcpy(text, digits, length);
+        text[length] = 'e';
+        int textLength = length + 1 + formatInt64(k, text + length + 1);
+        double check;
+        if (parseDouble(makeView(text, textLength), check).status == NUMBER_OK && check == value) break;
+    }
+    return length;
+}
+
+// Lays out digits * 10^k: plain notation for decimal exponents from -6 to
+// 21, otherwise d.ddde[+-]x
+static int layoutDecimal(char out[], const char digits[], int length, int k) {
+    int point = length + k;  // Position of the decimal point
+    if (length <= point && point <= 21) {
+        memcpy(out, digits, length);
+        memset(out + length, '0', point - length);
+        return point;
+    }
+    if (0 < point && point <= 21) {
+        memcpy(out, digits, point);
+        out[point] = '.';
+        memcpy(out + point + 1, digits + point, length - point);
+        return length + 1;
+    }
+    if (-6 < point && point <= 0) {
+        out[0] = '0';
+        out[1] = '.';
+        memset(out + 2, '0', -point);
+        memcpy(out + 2 - point, digits, length);
+        return 2 - point + length;
+    }
+    int pos = 0;
+    out[pos++] = digits[0];
+    if (length > 1) {
+        out[pos++] = '.';
+        memcpy(out + pos, digits + 1, length - 1);
+        pos += length - 1;
+    }
+    int exponent = point - 1;
+    out[pos++] = 'e';
+    out[pos++] = exponent < 0 ? '-' : '+';
+    if (exponent < 0) exponent = -exponent;
+    int exponentDigits = countDigits((uint64_t)exponent);
+    writeDigits(out + pos, (uint64_t)exponent, exponentDigits);
+    return pos + exponentDigits;
+}
+
+int formatDouble(double value, char out[]) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    int pos = 0;
+    if (bits >> 63) out[pos++] = '-';
+    uint64_t magnitude = bits & ~(1ULL << 63);
+    if (magnitude >= 0x7FF0000000000000ULL) {
+        if (magnitude > 0x7FF0000000000000ULL) pos = 0;  // No sign on NaN
+        memcpy(out + pos, magnitude > 0x7FF0000000000000ULL ? "nan" : "inf", 3);
+        pos += 3;
+    } else if (magnitude == 0) {
+        out[pos++] = '0';
+    } else {
+        char digits[20];
+        int k;
+        bool exact;
+        double positive = value < 0 ? -value : value;
+        int length = grisu3(positive, digits, k, exact);
+        if (!exact) length = exactShortestDigits(positive, length, digits, k);
+        pos += layoutDecimal(out + pos, digits, length, k);
+    }
+    out[pos] = '\0';
+    return pos;
+}
+
+// ---- Double parsing ----
+// Up to 19 significant digits are gathered into an integer m with decimal
+// exponent e. When m < 2^53 and 10^|e| is exact (|e| <= 22), m * 10^e or
+// m / 10^e is a single correctly rounded operation (Clinger's fast path).
+// Other inputs are passed to strtod, which assumes the "C" locale.
+
+static const double EXACT_POW10[23] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+// Case-insensitive match of a lowercase word at p
+static int matchWord(const char* p, int length, const char word[]) {
+    int i = 0;
+    for (; word[i] != '\0'; i++) {
+        if (i >= length || (p[i] | 0x20) != word[i]) return 0;
+    }
+    return i;
+}
+
+NumberResult parseDouble(StringView text, double& value) {
+    NumberResult result = {NUMBER_INVALID, 0};
+    value = 0.0;
+    const char* p = text.data;
+    int length = text.length;
+    int i = 0;
+    int negative = 0;
+    if (i < length && (p[i] == '-' || p[i] == '+')) negative = p[i++] == '-';
+
+    int word = matchWord(p + i, length - i, "infinity");
+    if (word == 0) word = matchWord(p + i, length - i, "inf");
+    if (word != 0) {
+        value = negative ? -HUGE_VAL : HUGE_VAL;
+        result.status = NUMBER_OK;
+        result.consumed = i + word;
+        return result;
+    }
+    word = matchWord(p + i, length - i, "nan");
+    if (word != 0) {
+        value = negative ? -NAN : NAN;
+        result.status = NUMBER_OK;
+        result.consumed = i + word;
+        return result;
+    }
+
+    uint64_t mantissa = 0;
+    int significant = 0;   // Digits held in mantissa
+    int dropped = 0;       // Non-zero digits that did not fit
+    int exponent = 0;
+    int digits = 0;
+    for (; i < length && p[i] >= '0' && p[i] <= '9'; i++, digits++) {
+        if (significant < 19) {
+            if (mantissa != 0 || p[i] != '0') {
+                mantissa = mantissa * 10 + (uint64_t)(p[i] - '0');
+                significant++;
+            }
+        } else {
+            exponent++;
+            dropped |= p[i] != '0';
+        }
+    }
+    if (i < length && p[i] == '.') {
+        int start = ++i;
+        // Eight fraction digits at a time while they fit in the mantissa
+        if (littleEndianHost()) {
+            while (significant > 0 && significant <= 11 && i + 8 <= length && isEightDigits(loadWord(p + i))) {
+                mantissa = mantissa * 100000000ULL + parseEightDigits(loadWord(p + i));
+                significant += 8;
+                exponent -= 8;
+                i += 8;
+            }
+        }
+        for (; i < length && p[i] >= '0' && p[i] <= '9'; i++) {
+            if (significant < 19) {
+                if (mantissa != 0 || p[i] != '0') {
+                    mantissa = mantissa * 10 + (uint64_t)(p[i] - '0');
+                    significant++;
+                }
+                exponent--;
+            } else {
+                dropped |= p[i] != '0';
+            }
+        }
+        digits += i - start;
+    }
+    if (digits == 0) return result;  // No digits, or a lone "."
+
+    if (i < length && (p[i] == 'e' || p[i] == 'E')) {
+        int j = i + 1;
+        int exponentNegative = 0;
+        if (j < length && (p[j] == '-' || p[j] == '+')) exponentNegative = p[j++] == '-';
+        if (j < length && p[j] >= '0' && p[j] <= '9') {
+            int written = 0;
+            for (; j < length && p[j] >= '0' && p[j] <= '9'; j++) {
+                if (written < 100000) written = written * 10 + (p[j] - '0');  // Saturate
+            }
+            exponent += exponentNegative ? -written : written;
+            i = j;
+        }
+    }
+    result.consumed = i;
+    result.status = NUMBER_OK;
+
+    if (mantissa == 0) {
+        value = negative ? -0.0 : 0.0;
+        return result;
+    }
+    if (!dropped && mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22) {
+        double m = (double)mantissa;
+        value = exponent < 0 ? m / EXACT_POW10[-exponent] : m * EXACT_POW10[exponent];
+        if (negative) value = -value;
+        return result;
+    }
+
+    char small[128];
+    char* copy = i < (int)sizeof(small) ? small : new char[i + 1];
+    memcpy(copy, p, i);
+    copy[i] = '\0';
+    value = strtod(copy, nullptr);
+    if (copy != small) delete[] copy;
+    if (value == HUGE_VAL || value == -HUGE_VAL) result.status = NUMBER_OVERFLOW;
+    return result;
+}
+
 // ==================== STRING TOKENIZATION ====================
 
 int splitString(const char str[], char delimiter, char tokens[][100], int maxTokens) {
@@ -404,14 +1858,11 @@ int splitString(const char str[], char delimiter, char tokens[][100], int maxTok
 // ==================== STRING MANIPULATION ====================
 
 void removeChar(char str[], char ch) {
-    int i = 0, j = 0;  // i reads, j writes
-    while (str[i] != '\0') {
-        if (str[i] != ch) {  // Keep character if not matching
-            str[j++] = str[i];
-        }
-        i++;
-    }
-    str[j] = '\0';  // Terminate string
+    removeChar(str, stringLength(str), ch);
+}
+
+void removeChars(char str[], const char set[]) {
+    removeChars(str, stringLength(str), makeView(set));
 }
 
 void capitalizeWords(char str[]) {
@@ -434,3 +1885,340 @@ void capitalizeFirst(char str[]) {
         str[0] = str[0] - 'a' + 'A';  // Convert to uppercase
     }
 }
+
+
+// ==================== STRING VIEWS ====================
+
+StringView makeView(const char str[]) {
+    StringView view = {str, stringLength(str)};
+    return view;
+}
+
+StringView makeView(const char data[], int length) {
+    StringView view = {data, length < 0 ? 0 : length};
+    return view;
+}
+
+StringView subview(StringView view, int start, int length) {
+    if (start < 0) start = 0;
+    if (start > view.length) start = view.length;
+    if (length < 0) length = 0;
+    if (length > view.length - start) length = view.length - start;
+    StringView result = {view.data + start, length};
+    return result;
+}
+
+StringView trimView(StringView view) {
+    int start = 0, end = view.length;
+    while (start < end && (view.data[start] == ' ' || view.data[start] == '\t')) start++;
+    while (end > start && (view.data[end - 1] == ' ' || view.data[end - 1] == '\t')) end--;
+    StringView result = {view.data + start, end - start};
+    return result;
+}
+
+int stringLength(StringView view) {
+    return view.length;
+}
+
+void stringCopy(char dest[], StringView src) {
+    memcpy(dest, src.data, src.length);
+    dest[src.length] = '\0';
+}
+
+int stringConcat(char dest[], int destLength, StringView src) {
+    stringCopy(dest + destLength, src);
+    return destLength + src.length;
+}
+
+// Same ordering as the null-terminated version: bytes compare as char and a
+// proper prefix sorts first
+int stringCompare(StringView str1, StringView str2) {
+    int common = str1.length < str2.length ? str1.length : str2.length;
+    int i = 0;
+    while (i + 8 <= common && loadWord(str1.data + i) == loadWord(str2.data + i)) i += 8;
+    while (i < common && str1.data[i] == str2.data[i]) i++;
+    if (i < common) return str1.data[i] < str2.data[i] ? -1 : 1;
+    if (str1.length == str2.length) return 0;
+    return str1.length < str2.length ? -1 : 1;
+}
+
+int stringEquals(StringView str1, StringView str2) {
+    return str1.length == str2.length && memcmp(str1.data, str2.data, str1.length) == 0;
+}
+
+int findChar(StringView view, char ch) {
+    if (view.length <= 0) return -1;
+    const void* hit = memchr(view.data, ch, view.length);
+    return hit ? (int)((const char*)hit - view.data) : -1;
+}
+
+// Small sets are matched with vector compares; larger ones use a 256-bit table
+int findAnyChar(StringView view, StringView set) {
+    if (set.length <= 0 || view.length <= 0) return -1;
+    if (set.length == 1) return findChar(view, set.data[0]);
+#ifdef CSTRING_X86_SIMD
+    if (set.length <= MAX_VECTOR_SET) {
+        const unsigned char* bytes = (const unsigned char*)set.data;
+        if (activeKernels().level >= SIMD_AVX2) return findAnyAvx2(view.data, view.length, bytes, set.length);
+        if (activeKernels().level >= SIMD_SSE2) return findAnySse2(view.data, view.length, bytes, set.length);
+    }
+#endif
+    uint64_t table[4] = {0, 0, 0, 0};
+    for (int s = 0; s < set.length; s++) {
+        unsigned char b = (unsigned char)set.data[s];
+        table[b >> 6] |= 1ULL << (b & 63);
+    }
+    for (int i = 0; i < view.length; i++) {
+        unsigned char b = (unsigned char)view.data[i];
+        if (table[b >> 6] & (1ULL << (b & 63))) return i;
+    }
+    return -1;
+}
+
+int findSubstring(StringView str, StringView substr) {
+    if (substr.length == 0) return 0;
+    if (substr.length > str.length) return -1;
+    if (substr.length == 1) return findChar(str, substr.data[0]);
+    SearchPattern pattern;
+    preparePattern(pattern, substr.data, substr.length);
+    return activeKernels().search(pattern, str.data, str.length, 0);
+}
+
+int countOccurrences(StringView view, char ch) {
+    int count = 0;
+    for (int i = 0; i < view.length; i++) {
+        if (view.data[i] == ch) count++;
+    }
+    return count;
+}
+
+int stringContains(StringView str, StringView substr) {
+    return findSubstring(str, substr) != -1;
+}
+
+int countVowels(StringView view) {
+    int letters, vowels;
+    activeKernels().countLetters(view.data, view.length, letters, vowels);
+    return vowels;
+}
+
+int countConsonants(StringView view) {
+    int letters, vowels;
+    activeKernels().countLetters(view.data, view.length, letters, vowels);
+    return letters - vowels;
+}
+
+int countWords(StringView view) {
+    int count = 0;
+    int inWord = 0;
+    for (int i = 0; i < view.length; i++) {
+        char ch = view.data[i];
+        if (ch != ' ' && ch != '\t' && ch != '\n') {
+            if (!inWord) count++;
+            inWord = 1;
+        } else {
+            inWord = 0;
+        }
+    }
+    return count;
+}
+
+int isPalindrome(StringView view) {
+    for (int i = 0, j = view.length - 1; i < j; i++, j--) {
+        if (view.data[i] != view.data[j]) return 0;
+    }
+    return 1;
+}
+
+int isAlpha(StringView view) {
+    return view.length > 0 && activeKernels().classSpan(view.data, view.length, CLASS_ALPHA) == view.length;
+}
+
+int isDigit(StringView view) {
+    return view.length > 0 && activeKernels().classSpan(view.data, view.length, CLASS_DIGIT) == view.length;
+}
+
+int isAlphaNumeric(StringView view) {
+    return view.length > 0 &&
+           activeKernels().classSpan(view.data, view.length, CLASS_ALPHA | CLASS_DIGIT) == view.length;
+}
+
+void substring(StringView str, int start, int length, char result[]) {
+    if (start < 0 || start >= str.length || length <= 0) {  // Validate parameters
+        result[0] = '\0';
+        return;
+    }
+    stringCopy(result, subview(str, start, length));
+}
+
+int stringToInt(StringView view) {
+    int i = 0;
+    while (i < view.length && (view.data[i] == ' ' || view.data[i] == '\t')) i++;
+    int sign = 1;
+    if (i < view.length && (view.data[i] == '-' || view.data[i] == '+')) {
+        if (view.data[i] == '-') sign = -1;
+        i++;
+    }
+    int result = 0;
+    while (i < view.length && isCharDigit(view.data[i])) result = result * 10 + (view.data[i++] - '0');
+    return result * sign;
+}
+
+// Empty tokens (adjacent delimiters) are skipped, as in the copying version
+int splitString(StringView str, char delimiter, StringView tokens[], int maxTokens) {
+    int tokenCount = 0;
+    int start = 0;
+    while (start < str.length && tokenCount < maxTokens) {
+        StringView rest = subview(str, start, str.length - start);
+        int end = findChar(rest, delimiter);
+        int tokenLength = end < 0 ? rest.length : end;
+        if (tokenLength > 0) tokens[tokenCount++] = subview(rest, 0, tokenLength);
+        start += tokenLength + 1;
+    }
+    return tokenCount;
+}
+
+void reverseString(char str[], int length) {
+    for (int i = 0, j = length - 1; i < j; i++, j--) {
+        char temp = str[i];
+        str[i] = str[j];
+        str[j] = temp;
+    }
+}
+
+void toUpperCase(char str[], int length) {
+    activeKernels().changeCase(str, length, 'a', 'z');
+}
+
+void toLowerCase(char str[], int length) {
+    activeKernels().changeCase(str, length, 'A', 'Z');
+}
+
+int removeSpaces(char str[], int length) {
+    return removeChar(str, length, ' ');
+}
+
+int trimString(char str[], int length) {
+    StringView trimmed = trimView(makeView(str, length));
+    memmove(str, trimmed.data, trimmed.length);
+    str[trimmed.length] = '\0';
+    return trimmed.length;
+}
+
+void replaceChar(char str[], int length, char oldChar, char newChar) {
+    for (int i = 0; i < length; i++) {
+        if (str[i] == oldChar) str[i] = newChar;
+    }
+}
+
+int insertString(char str[], int length, StringView insert, int pos) {
+    if (pos < 0 || pos > length) return length;  // Validate position
+    memmove(str + pos + insert.length, str + pos, length - pos + 1);  // Includes terminator
+    memcpy(str + pos, insert.data, insert.length);
+    return length + insert.length;
+}
+
+int removeChar(char str[], int length, char ch) {
+    return removeChars(str, length, makeView(&ch, 1));
+}
+
+int removeChars(char str[], int length, StringView set) {
+    return filterChars(str, makeView(str, length), set);
+}
+
+int filterChars(char dest[], StringView src, StringView set) {
+    ByteSet bytes;
+    makeByteSet(bytes, set.data, set.length);
+    int kept = src.length;
+    if (bytes.count == 0) {
+        if (dest != src.data) memmove(dest, src.data, src.length);
+    } else {
+        kept = activeKernels().compact(dest, src.data, src.length, bytes);
+    }
+    dest[kept] = '\0';
+    return kept;
+}
+
+void capitalizeWords(char str[], int length) {
+    int capitalizeNext = 1;
+    for (int i = 0; i < length; i++) {
+        if (str[i] == ' ' || str[i] == '\t' || str[i] == '\n') {
+            capitalizeNext = 1;
+        } else {
+            if (capitalizeNext && str[i] >= 'a' && str[i] <= 'z') str[i] = str[i] - 'a' + 'A';
+            capitalizeNext = 0;
+        }
+    }
+}
+
+// ==================== BATCH OPERATIONS ====================
+
+static void changeCaseBatch(char* const strings[], const int lengths[], int count, char first, char last) {
+    void (*changeCase)(char[], int, char, char) = activeKernels().changeCase;
+    for (int i = 0; i < count; i++) changeCase(strings[i], lengths[i], first, last);
+}
+
+void toUpperCaseBatch(char* const strings[], const int lengths[], int count) {
+    changeCaseBatch(strings, lengths, count, 'a', 'z');
+}
+
+void toLowerCaseBatch(char* const strings[], const int lengths[], int count) {
+    changeCaseBatch(strings, lengths, count, 'A', 'Z');
+}
+
+// Case conversion never moves bytes, so the column is converted as one
+// span: vectors run straight across string boundaries
+void toUpperCasePacked(char bytes[], const uint32_t offsets[], int count) {
+    if (count <= 0) return;
+    activeKernels().changeCase(bytes + offsets[0], (int)(offsets[count] - offsets[0]), 'a', 'z');
+}
+
+void toLowerCasePacked(char bytes[], const uint32_t offsets[], int count) {
+    if (count <= 0) return;
+    activeKernels().changeCase(bytes + offsets[0], (int)(offsets[count] - offsets[0]), 'A', 'Z');
+}
+
+void unpackViews(const char bytes[], const uint32_t offsets[], int count, StringView views[]) {
+    for (int i = 0; i < count; i++) {
+        views[i].data = bytes + offsets[i];
+        views[i].length = (int)(offsets[i + 1] - offsets[i]);
+    }
+}
+
+void trimBatch(StringView views[], int count) {
+    for (int i = 0; i < count; i++) views[i] = trimView(views[i]);
+}
+
+#ifdef CSTRING_X86_SIMD
+// Pairs of at most 16 bytes are compared with one load each when neither
+// load crosses a page; the first differing byte is the lowest mismatch bit
+CSTRING_OVERREAD static void compareBatchSse2(const StringView a[], const StringView b[], int count, int results[]) {
+    for (int i = 0; i < count; i++) {
+        const char* x = a[i].data;
+        const char* y = b[i].data;
+        int common = a[i].length < b[i].length ? a[i].length : b[i].length;
+        if (common == 0 || common > 16 || roomInPage(x) < 16 || roomInPage(y) < 16) {
+            results[i] = stringCompare(a[i], b[i]);
+            continue;
+        }
+        __m128i equal = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)x), _mm_loadu_si128((const __m128i*)y));
+        unsigned differ = ~(unsigned)_mm_movemask_epi8(equal) | (1u << common);  // Stop at the shorter end
+        int at = lowestBit(differ);
+        if (at < common) {
+            results[i] = x[at] < y[at] ? -1 : 1;
+        } else {
+            results[i] = a[i].length == b[i].length ? 0 : (a[i].length < b[i].length ? -1 : 1);
+        }
+    }
+}
+#endif
+
+void compareBatch(const StringView a[], const StringView b[], int count, int results[]) {
+#ifdef CSTRING_X86_SIMD
+    if (activeKernels().level >= SIMD_SSE2) {
+        compareBatchSse2(a, b, count, results);
+        return;
+    }
+#endif
+    for (int i = 0; i < count; i++) results[i] = stringCompare(a[i], b[i]);
+}
@@ -4,6 +4,24 @@
 #ifndef CSTRING_H
 #define CSTRING_H
 
+#include <cstdint>
+
+// SIMD dispatch levels for the bulk primitives (length, copy, compare, search).
+// The best level the CPU supports is selected automatically on first use
+enum StringSimdLevel {
+    SIMD_SCALAR = 0,  // Byte-at-a-time reference loops
+    SIMD_WORD = 1,    // 8 bytes per step in a 64-bit register (portable)
+    SIMD_SSE2 = 2,    // 16-byte vectors (x86)
+    SIMD_AVX2 = 3     // 32-byte vectors (x86, detected at runtime)
+};
+
+// Level currently in use
+int stringSimdLevel();
+
+// Forces a level (clamped to what the CPU supports) and returns the level
+// actually selected. Not thread-safe: call before other threads use the library
+int setStringSimdLevel(int level);
+
 // String length and basic operations
 int stringLength(const char str[]);
 void stringCopy(char dest[], const char src[]);
@@ -13,6 +31,30 @@ int stringCompare(const char str1[], const char str2[]);
 // String search and manipulation
 int findChar(const char str[], char ch);
 int findSubstring(const char str[], const char substr[]);
+
+// Compiled substring search: preprocess a pattern once, then search any
+// number of texts in linear worst-case time (Two-Way algorithm with a
+// last-byte skip table; SSE2/AVX2 levels first filter candidates by
+// comparing the pattern's first and last bytes 16/32 positions at a time)
+struct SearchPattern {
+    char* bytes;      // Copy of the pattern
+    int length;
+    int critical;     // Critical factorization: bytes[0..critical] | rest
+    int period;       // Shift after a full mismatch-free right half
+    int periodic;     // 1 if the left half may be skipped after a shift
+    int shift[256];   // 1 + last index of each byte in the pattern, 0 if absent
+};
+
+// Preprocesses str in O(length). Returns 1 on success
+int compilePattern(SearchPattern& pattern, const char str[]);
+void freePattern(SearchPattern& pattern);
+
+// Index of the first match in a null-terminated text, or -1
+int findPattern(const SearchPattern& pattern, const char text[]);
+
+// Index of the first match at or after start in text[0..length), or -1.
+// text need not be null-terminated
+int findPatternIn(const SearchPattern& pattern, const char text[], int length, int start);
 void reverseString(char str[]);
 void toUpperCase(char str[]);
 void toLowerCase(char str[]);
@@ -59,7 +101,133 @@ int splitString(const char str[], char delimiter, char tokens[][100], int maxTok
 
 // String manipulation
 void removeChar(char str[], char ch);
+void removeChars(char str[], const char set[]);  // Removes every byte that occurs in set
 void capitalizeWords(char str[]);
 void capitalizeFirst(char str[]);
 
+// ==================== STRING VIEWS ====================
+// A view is a pointer plus a length into existing characters. It owns
+// nothing and need not be null-terminated. Overloads taking views (or an
+// explicit buffer length) never rescan for the terminator, so chains of
+// operations stay linear. Views are built explicitly with makeView.
+
+struct StringView {
+    const char* data;
+    int length;
+};
+
+// View of a null-terminated string (one length scan)
+StringView makeView(const char str[]);
+
+// View of length bytes at data
+StringView makeView(const char data[], int length);
+
+// O(1) sub-view; start and length are clamped to the view
+StringView subview(StringView view, int start, int length);
+
+// View without leading/trailing spaces and tabs, O(trimmed bytes)
+StringView trimView(StringView view);
+
+// Basic operations
+int stringLength(StringView view);
+void stringCopy(char dest[], StringView src);              // Writes src and a terminator
+int stringConcat(char dest[], int destLength, StringView src);  // Returns the new length
+int stringCompare(StringView str1, StringView str2);
+int stringEquals(StringView str1, StringView str2);       // O(1) when lengths differ
+
+// Search
+int findChar(StringView view, char ch);
+int findAnyChar(StringView view, StringView set);  // First byte that is in set, or -1
+int findSubstring(StringView str, StringView substr);
+int countOccurrences(StringView view, char ch);
+int stringContains(StringView str, StringView substr);
+
+// Analysis and validation
+int countVowels(StringView view);
+int countConsonants(StringView view);
+int countWords(StringView view);
+int isPalindrome(StringView view);
+int isAlpha(StringView view);
+int isDigit(StringView view);
+int isAlphaNumeric(StringView view);
+
+// Extraction, conversion and tokenization
+void substring(StringView str, int start, int length, char result[]);
+int stringToInt(StringView view);
+int splitString(StringView str, char delimiter, StringView tokens[], int maxTokens);  // Zero-copy
+
+// In-place operations on a buffer of known length (terminator maintained);
+// those that change the length return the new one
+void reverseString(char str[], int length);
+void toUpperCase(char str[], int length);
+void toLowerCase(char str[], int length);
+int removeSpaces(char str[], int length);
+int trimString(char str[], int length);
+void replaceChar(char str[], int length, char oldChar, char newChar);
+int insertString(char str[], int length, StringView insert, int pos);
+int removeChar(char str[], int length, char ch);
+int removeChars(char str[], int length, StringView set);
+
+// Copies src to dest without the bytes in set and adds a terminator; returns
+// the new length. dest needs src.length + 1 bytes and may equal src.data
+int filterChars(char dest[], StringView src, StringView set);
+void capitalizeWords(char str[], int length);
+
+// ==================== BATCH OPERATIONS ====================
+// One call handles many strings, so the kernel choice and call overhead are
+// paid once per batch. A packed column is a byte buffer plus count + 1
+// offsets: string i is bytes[offsets[i], offsets[i + 1]).
+
+// Case conversion of strings[i][0, lengths[i])
+void toUpperCaseBatch(char* const strings[], const int lengths[], int count);
+void toLowerCaseBatch(char* const strings[], const int lengths[], int count);
+
+// Case conversion of a whole packed column in one vectorized pass
+void toUpperCasePacked(char bytes[], const uint32_t offsets[], int count);
+void toLowerCasePacked(char bytes[], const uint32_t offsets[], int count);
+
+// views[i] = string i of a packed column
+void unpackViews(const char bytes[], const uint32_t offsets[], int count, StringView views[]);
+
+// views[i] = trimView(views[i])
+void trimBatch(StringView views[], int count);
+
+// results[i] = stringCompare(a[i], b[i]); short pairs take one vector compare
+void compareBatch(const StringView a[], const StringView b[], int count, int results[]);
+
+// ==================== NUMBER CONVERSION ====================
+// Formatting writes digits front to back, two per step, adds a terminator and
+// returns the length; a buffer of NUMBER_BUFFER_SIZE always suffices.
+// Parsing reads an optional sign and the number at the start of a view (no
+// whitespace skipping) and reports the bytes consumed.
+
+const int NUMBER_BUFFER_SIZE = 32;
+
+enum NumberStatus {
+    NUMBER_OK = 0,
+    NUMBER_INVALID = 1,   // No number at the start of the text (consumed = 0)
+    NUMBER_OVERFLOW = 2   // Out of range: the value is clamped (or +-inf)
+};
+
+struct NumberResult {
+    int status;
+    int consumed;
+};
+
+int formatInt64(long long value, char out[]);
+int formatUint64(unsigned long long value, char out[]);
+
+// Shortest digits that read back as the same double (the closest such string
+// when there are several): "0.1", "1e+21", "-5e-324", "inf", "nan". Grisu3,
+// with a slower snprintf search for the ~0.5% of values it cannot verify.
+// Plain notation for decimal exponents from -6 to 21
+int formatDouble(double value, char out[]);
+
+NumberResult parseInt64(StringView text, long long& value);
+NumberResult parseUint64(StringView text, unsigned long long& value);  // Optional '+'
+
+// Decimal floating point: [+-]digits[.digits][(e|E)[+-]digits], inf,
+// infinity or nan (any case). Correctly rounded
+NumberResult parseDouble(StringView text, double& value);
+
 #endif
\ No newline at end of file
@@ -1,5 +1,10 @@
+#include <cstdio>
 #include <iostream>
 #include "cstring.h"
+#include "multipattern.h"
+#include "stringbuilder.h"
+#include "stringcolumn.h"
+#include "tokenizer.h"
 
 using namespace std;
 
@@ -27,6 +32,24 @@ void testBasicOperations() {
     cout << "Compare \"" << s1 << "\" and \"" << s2 << "\": " << stringCompare(s1, s2) << "\n";
 }
 
+void testSimdDispatch() {
+    cout << "\n========== SIMD DISPATCH ==========\n";
+
+    const char* names[] = {"scalar", "word", "sse2", "avx2"};
+    cout << "Active level: " << names[stringSimdLevel()] << "\n";
+
+    // Every level gives the same answers
+    char text[] = "The quick brown fox jumps over the lazy dog";
+    int best = stringSimdLevel();
+    for (int level = SIMD_SCALAR; level <= best; level++) {
+        setStringSimdLevel(level);
+        cout << names[level] << ": length " << stringLength(text)
+             << ", find 'z' " << findChar(text, 'z')
+             << ", compare " << stringCompare(text, "The quick") << "\n";
+    }
+    setStringSimdLevel(best);
+}
+
 void testSearchOperations() {
     cout << "\n========== STRING SEARCH OPERATIONS ==========\n";
     
@@ -39,6 +62,20 @@ void testSearchOperations() {
     // findSubstring
     cout << "Find \"World\": Index " << findSubstring(text, "World") << "\n\n";
     
+    // Compiled pattern reused across texts
+    SearchPattern pattern;
+    compilePattern(pattern, "ing");
+    cout << "Compiled \"ing\" in text: Index " << findPattern(pattern, text) << "\n";
+    cout << "Compiled \"ing\" in \"Testing strings\": Indexes ";
+    const char log[] = "Testing strings";
+    int length = stringLength(log);
+    for (int pos = findPatternIn(pattern, log, length, 0); pos != -1;
+         pos = findPatternIn(pattern, log, length, pos + 1)) {
+        cout << pos << " ";
+    }
+    cout << "\n\n";
+    freePattern(pattern);
+
     // countOccurrences
     cout << "Count 'o': " << countOccurrences(text, 'o') << " times\n\n";
     
@@ -46,6 +83,27 @@ void testSearchOperations() {
     cout << "Contains \"Program\": " << (stringContains(text, "Program") ? "Yes" : "No") << "\n";
 }
 
+void testMultiPattern() {
+    cout << "\n========== MULTI-PATTERN SEARCH ==========\n";
+
+    const char* keywords[] = {"he", "she", "his", "hers"};
+    MultiPattern matcher;
+    buildMultiPattern(matcher, keywords, 4);
+
+    char text[] = "ushers and his sheep";
+    cout << "Text: \"" << text << "\"\n";
+    PatternMatch matches[16];
+    int found = findAllPatterns(matcher, text, stringLength(text), matches, 16);
+    for (int i = 0; i < found; i++) {
+        cout << "  \"" << keywords[matches[i].pattern] << "\" at " << matches[i].start << "\n";
+    }
+
+    int counts[4];
+    int total = countPatterns(matcher, text, stringLength(text), counts);
+    cout << "Total matches: " << total << " (\"he\" x" << counts[0] << ")\n";
+    freeMultiPattern(matcher);
+}
+
 void testManipulation() {
     cout << "\n========== STRING MANIPULATION ==========\n";
     
@@ -139,6 +197,11 @@ void testModification() {
     cout << "Original: \"" << str << "\"\n";
     removeChar(str, 'l');
     cout << "Remove 'l': \"" << str << "\"\n";
+
+    // removeChars
+    char header[] = "Content-Type:\ttext/html\r\n";
+    removeChars(header, " \t\r\n");
+    cout << "Strip whitespace: \"" << header << "\"\n";
 }
 
 void testExtraction() {
@@ -186,6 +249,172 @@ void testConversion() {
     int num2 = stringToInt("-123");
     cout << "String \"42\" to int: " << num1 << "\n";
     cout << "String \"-123\" to int: " << num2 << "\n";
+
+    // 64-bit and floating-point conversion with error reporting
+    char number[NUMBER_BUFFER_SIZE];
+    formatInt64(-9223372036854775807LL - 1, number);
+    cout << "\nformatInt64(INT64_MIN): \"" << number << "\"\n";
+    formatDouble(0.1 + 0.2, number);
+    cout << "formatDouble(0.1 + 0.2): \"" << number << "\"\n";
+
+    const char* fields[] = {"12345,next", "99999999999999999999", "abc", "-2.5e-3"};
+    for (const char* field : fields) {
+        long long integer;
+        double real;
+        NumberResult asInt = parseInt64(makeView(field), integer);
+        NumberResult asDouble = parseDouble(makeView(field), real);
+        const char* status[] = {"ok", "invalid", "overflow"};
+        cout << "\"" << field << "\": int " << integer << " (" << status[asInt.status] << ", " << asInt.consumed
+             << " bytes), double " << real << " (" << status[asDouble.status] << ", " << asDouble.consumed << " bytes)\n";
+    }
+}
+
+void testTokenizer() {
+    cout << "\n========== LAZY TOKENIZER ==========\n";
+
+    Tokenizer t;
+    Token token;
+    initSetTokenizer(t, makeView("split  on\tany\nwhitespace"), makeView(" \t\n"));
+    t.skipEmpty = 1;
+    cout << "Set delimiters:";
+    while (nextToken(t, token)) cout << " [" << string(token.view.data, token.view.length) << "]";
+    cout << "\n";
+
+    initStringTokenizer(t, makeView("a::b::::c"), makeView("::"));
+    cout << "String delimiter:";
+    while (nextToken(t, token)) cout << " [" << string(token.view.data, token.view.length) << "]";
+    cout << "\n";
+
+    const char csv[] = "name,quote\r\nAda,\"Hello, \"\"World\"\"\"\nAlan,\n";
+    initCsvTokenizer(t, makeView(csv), ',');
+    char field[64];
+    cout << "CSV records:\n ";
+    while (nextToken(t, token)) {
+        unescapeCsvField(token, field);
+        cout << " [" << field << "]";
+        if (token.endOfRecord) cout << "\n ";
+    }
+    cout << "\n";
+}
+
+void testBatchOperations() {
+    cout << "\n========== BATCH OPERATIONS ==========\n";
+
+    // A packed column: strings back to back, string i at [offsets[i], offsets[i + 1])
+    char bytes[] = "  Alpha BETA  Gamma";
+    uint32_t offsets[] = {0, 7, 12, 19};
+    toLowerCasePacked(bytes, offsets, 3);
+
+    StringView views[3];
+    unpackViews(bytes, offsets, 3, views);
+    trimBatch(views, 3);
+    StringView keys[3] = {makeView("alpha"), makeView("alpha"), makeView("zeta")};
+    int results[3];
+    compareBatch(views, keys, 3, results);
+    for (int i = 0; i < 3; i++) {
+        cout << "  \"" << string(views[i].data, views[i].length) << "\" vs \""
+             << string(keys[i].data, keys[i].length) << "\": " << results[i] << "\n";
+    }
+}
+
+void testStringColumn() {
+    cout << "\n========== STRING COLUMN ==========\n";
+
+    StringColumn words;
+    initColumn(words, 0, 0);
+    int added = columnAppendSplit(words, makeView("pear,apple,,fig,apple,banana,fig"), ',');
+    sortColumn(words);
+    int unique = dedupColumn(words);
+    cout << "Split " << added << " tokens, " << unique << " unique after sort + dedup:";
+    for (int i = 0; i < words.count; i++) {
+        StringView word = columnGet(words, i);
+        cout << " " << string(word.data, word.length);
+    }
+    cout << "\n";
+
+    const char path[] = "demo_words.col";
+    if (saveColumn(words, path)) {
+        StringColumn mapped;
+        if (mapColumn(mapped, path)) {
+            toUpperCasePacked(mapped.bytes, mapped.offsets, mapped.count);  // Private to this process
+            StringView last = columnGet(mapped, mapped.count - 1);
+            cout << "Mapped " << mapped.count << " strings from " << path << ", last uppercased: "
+                 << string(last.data, last.length) << "\n";
+            freeColumn(mapped);
+        }
+        remove(path);
+    }
+    freeColumn(words);
+}
+
+void testStringViews() {
+    cout << "\n========== STRING VIEWS ==========\n";
+
+    char line[100] = "  name = Ada Lovelace ; born = 1815  ";
+    int length = trimString(line, stringLength(line));
+    cout << "Trimmed: \"" << line << "\" (" << length << " chars)\n";
+
+    // Zero-copy split and trim: views point into line
+    StringView fields[4];
+    int count = splitString(makeView(line, length), ';', fields, 4);
+    for (int i = 0; i < count; i++) {
+        StringView pair[2];
+        splitString(fields[i], '=', pair, 2);
+        StringView key = trimView(pair[0]);
+        StringView value = trimView(pair[1]);
+        cout << "  " << string(key.data, key.length) << " -> \"" << string(value.data, value.length) << "\"";
+        if (isDigit(value)) cout << " (number " << stringToInt(value) << ")";
+        cout << "\n";
+    }
+
+    // Appending with a known length avoids rescanning dest
+    char out[100] = "";
+    int outLength = 0;
+    outLength = stringConcat(out, outLength, makeView("Hello"));
+    outLength = stringConcat(out, outLength, makeView(", World", 7));
+    cout << "Built: \"" << out << "\" (" << outLength << " chars)\n";
+}
+
+void testStringBuilder() {
+    cout << "\n========== STRING BUILDER ==========\n";
+
+    StringBuilder json;
+    initBuilder(json, 0);
+    const char* names[] = {"apple", "banana", "cherry"};
+    builderAppend(json, "[");
+    for (int i = 0; i < 3; i++) {
+        if (i > 0) builderAppendChar(json, ',');
+        builderAppend(json, "{\"id\":");
+        builderAppendInt(json, 1000 + i);
+        builderAppend(json, ",\"name\":\"");
+        builderAppend(json, names[i]);
+        builderAppend(json, "\"}");
+    }
+    builderAppendChar(json, ']');
+    cout << "JSON: " << json.data << "\n";
+    cout << "Length " << json.length << ", capacity " << json.capacity << "\n";
+    freeBuilder(json);
+
+    // Appending a builder to itself is safe even when the buffer grows
+    StringBuilder twice;
+    initBuilder(twice, 0);
+    builderAppend(twice, "0123456789abcde");
+    builderAppend(twice, builderView(twice));
+    cout << "Self-append: " << twice.data << "\n";
+    freeBuilder(twice);
+
+    // Arena-backed builders are released together
+    StringArena arena;
+    initArena(arena, 4096);
+    for (int i = 1; i <= 3; i++) {
+        StringBuilder line;
+        initBuilder(line, arena, 32);
+        builderAppend(line, "row ");
+        builderAppendInt(line, i);
+        builderAppendRepeat(line, '.', i);
+        cout << line.data << "\n";
+    }
+    freeArena(arena);
 }
 
 void testTokenization() {
@@ -211,7 +440,9 @@ int main() {
     cout << "===============================================\n";
     
     testBasicOperations();
+    testSimdDispatch();
     testSearchOperations();
+    testMultiPattern();
     testManipulation();
     testAnalysis();
     testModification();
@@ -219,6 +450,11 @@ int main() {
     testValidation();
     testConversion();
     testTokenization();
+    testTokenizer();
+    testStringViews();
+    testBatchOperations();
+    testStringColumn();
+    testStringBuilder();
     
     cout << "\n===============================================\n";
     cout << "    ALL TESTS COMPLETED SUCCESSFULLY!\n";
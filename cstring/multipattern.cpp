@@ -0,0 +1,200 @@
+// Multi-Pattern String Search
+// Author: Pranjul Gupta
+
+#include "multipattern.h"
+#include "cstring.h"
+#include <vector>
+
+// ==================== CONSTRUCTION ====================
+
+int buildMultiPattern(MultiPattern& matcher, const char* const patterns[], int count) {
+    matcher.transitions = nullptr;
+    matcher.outputOffsets = nullptr;
+    matcher.outputIds = nullptr;
+    matcher.dictionaryLinks = nullptr;
+    matcher.patternLengths = nullptr;
+    matcher.classCount = 0;
+    matcher.stateCount = 0;
+    matcher.firstMatchState = 0;
+    matcher.patternCount = 0;
+    if (count <= 0) return 0;
+
+    std::vector<int> lengths(count);
+    for (int p = 0; p < count; p++) {
+        lengths[p] = stringLength(patterns[p]);
+        if (lengths[p] == 0) return 0;  // Empty patterns would match everywhere
+    }
+
+    // Byte classes: class 0 for bytes in no pattern, then one per used byte
+    bool used[256] = {false};
+    for (int p = 0; p < count; p++) {
+        for (int i = 0; i < lengths[p]; i++) used[(unsigned char)patterns[p][i]] = true;
+    }
+    int classes = 1;
+    for (int b = 0; b < 256; b++) matcher.byteClass[b] = used[b] ? (unsigned char)classes++ : 0;
+    // 256 used bytes would need class 256; fold class 0 into the last byte then
+    if (classes > 256) {
+        for (int b = 0; b < 256; b++) matcher.byteClass[b] = (unsigned char)b;
+        classes = 256;
+    }
+
+    // Trie
+    std::vector<int> next(classes, -1);
+    std::vector<std::vector<int> > own(1);
+    for (int p = 0; p < count; p++) {
+        int state = 0;
+        for (int i = 0; i < lengths[p]; i++) {
+            int c = matcher.byteClass[(unsigned char)patterns[p][i]];
+            if (next[state * classes + c] == -1) {
+                next[state * classes + c] = (int)own.size();
+                own.push_back(std::vector<int>());
+                next.resize(own.size() * classes, -1);
+            }
+            state = next[state * classes + c];
+        }
+        own[state].push_back(p);
+    }
+    int states = (int)own.size();
+
+    // Breadth-first failure links, completing the goto function into a DFA
+    std::vector<int> fail(states, 0), dictionary(states, -1), queue;
+    queue.reserve(states);
+    for (int c = 0; c < classes; c++) {
+        int child = next[c];
+        if (child == -1) {
+            next[c] = 0;
+        } else {
+            queue.push_back(child);
+        }
+    }
+    for (int head = 0; head < (int)queue.size(); head++) {
+        int u = queue[head];
+        for (int c = 0; c < classes; c++) {
+            int v = next[u * classes + c];
+            int viaFail = next[fail[u] * classes + c];
+            if (v == -1) {
+                next[u * classes + c] = viaFail;
+            } else {
+                fail[v] = viaFail;
+                dictionary[v] = own[viaFail].empty() ? dictionary[viaFail] : viaFail;
+                queue.push_back(v);
+            }
+        }
+    }
+
+    // Renumber so that states reporting matches come last; the scan loop then
+    // needs a single comparison per byte to detect them
+    std::vector<int> newId(states), order;
+    order.reserve(states);
+    for (int pass = 0; pass < 2; pass++) {
+        for (int s = 0; s < states; s++) {
+            bool matching = !own[s].empty() || dictionary[s] != -1;
+            if (matching == (pass == 1)) {
+                newId[s] = (int)order.size();
+                order.push_back(s);
+            }
+        }
+    }
+    int firstMatch = states;
+    for (int s = 0; s < states; s++) {
+        if (!own[s].empty() || dictionary[s] != -1) {
+            if (newId[s] < firstMatch) firstMatch = newId[s];
+        }
+    }
+
+    matcher.transitions = new int[(long long)states * classes];
+    matcher.outputOffsets = new int[states + 1];
+    matcher.dictionaryLinks = new int[states];
+    matcher.patternLengths = new int[count];
+    matcher.outputIds = new int[count];
+    int outputs = 0;
+    for (int n = 0; n < states; n++) {
+        int s = order[n];
+        for (int c = 0; c < classes; c++) {
+            matcher.transitions[n * classes + c] = newId[next[s * classes + c]] * classes;
+        }
+        matcher.outputOffsets[n] = outputs;
+        for (int i = 0; i < (int)own[s].size(); i++) matcher.outputIds[outputs++] = own[s][i];
+        matcher.dictionaryLinks[n] = dictionary[s] == -1 ? -1 : newId[dictionary[s]];
+    }
+    matcher.outputOffsets[states] = outputs;
+    for (int p = 0; p < count; p++) matcher.patternLengths[p] = lengths[p];
+    matcher.classCount = classes;
+    matcher.stateCount = states;
+    matcher.firstMatchState = firstMatch * classes;
+    matcher.patternCount = count;
+    return 1;
+}
+
+void freeMultiPattern(MultiPattern& matcher) {
+    delete[] matcher.transitions;
+    delete[] matcher.outputOffsets;
+    delete[] matcher.outputIds;
+    delete[] matcher.dictionaryLinks;
+    delete[] matcher.patternLengths;
+    matcher.transitions = nullptr;
+    matcher.outputOffsets = nullptr;
+    matcher.outputIds = nullptr;
+    matcher.dictionaryLinks = nullptr;
+    matcher.patternLengths = nullptr;
+    matcher.stateCount = 0;
+    matcher.patternCount = 0;
+}
+
+// ==================== SEARCH ====================
+
+// Runs the automaton over text and calls report(patternId, endIndex) for every
+// occurrence; report returns false to stop the scan
+template <typename Report>
+static void scanText(const MultiPattern& matcher, const char text[], int length, Report report) {
+    if (matcher.stateCount == 0) return;
+    const int* transitions = matcher.transitions;
+    const unsigned char* byteClass = matcher.byteClass;
+    int firstMatch = matcher.firstMatchState;
+    int state = 0;
+    for (int i = 0; i < length; i++) {
+        state = transitions[state + byteClass[(unsigned char)text[i]]];
+        if (state < firstMatch) continue;
+        for (int s = state / matcher.classCount; s != -1; s = matcher.dictionaryLinks[s]) {
+            for (int o = matcher.outputOffsets[s]; o < matcher.outputOffsets[s + 1]; o++) {
+                if (!report(matcher.outputIds[o], i + 1)) return;
+            }
+        }
+    }
+}
+
+int findAllPatterns(const MultiPattern& matcher, const char text[], int length,
+                    PatternMatch matches[], int maxMatches) {
+    int found = 0;
+    if (maxMatches <= 0) return 0;
+    scanText(matcher, text, length, [&](int pattern, int end) {
+        matches[found].pattern = pattern;
+        matches[found].start = end - matcher.patternLengths[pattern];
+        matches[found].end = end;
+        return ++found < maxMatches;
+    });
+    return found;
+}
+
+int findFirstPattern(const MultiPattern& matcher, const char text[], int length, PatternMatch& match) {
+    int found = 0;
+    scanText(matcher, text, length, [&](int pattern, int end) {
+        match.pattern = pattern;
+        match.start = end - matcher.patternLengths[pattern];
+        match.end = end;
+        found = 1;
+        return false;
+    });
+    return found;
+}
+
+int countPatterns(const MultiPattern& matcher, const char text[], int length, int counts[]) {
+    for (int p = 0; p < matcher.patternCount; p++) counts[p] = 0;
+    int total = 0;
+    scanText(matcher, text, length, [&](int pattern, int) {
+        counts[pattern]++;
+        total++;
+        return true;
+    });
+    return total;
+}
@@ -0,0 +1,49 @@
+// Multi-Pattern String Search
+// Author: Pranjul Gupta
+
+#ifndef MULTIPATTERN_H
+#define MULTIPATTERN_H
+
+// Aho-Corasick automaton: finds every occurrence of every pattern in one
+// pass over the text, one table lookup per text byte regardless of how many
+// patterns there are. Bytes are mapped to equivalence classes (bytes that
+// appear in no pattern share one class), which keeps the dense transition
+// table small: states x classes entries.
+struct MultiPattern {
+    int* transitions;          // states x classCount, premultiplied by classCount
+    int* outputOffsets;        // Patterns ending exactly at state s: outputIds[offsets[s]..offsets[s+1])
+    int* outputIds;
+    int* dictionaryLinks;      // Nearest proper suffix state with outputs, -1 if none
+    int* patternLengths;
+    unsigned char byteClass[256];
+    int classCount;
+    int stateCount;
+    int firstMatchState;       // Premultiplied ids at or above this report matches
+    int patternCount;
+};
+
+// One occurrence: text[start, end) equals pattern number `pattern`
+struct PatternMatch {
+    int pattern;
+    int start;
+    int end;
+};
+
+// Builds the automaton in O(total pattern length x classes).
+// Returns 1 on success, 0 if count <= 0 or any pattern is empty
+int buildMultiPattern(MultiPattern& matcher, const char* const patterns[], int count);
+void freeMultiPattern(MultiPattern& matcher);
+
+// Writes up to maxMatches occurrences, ordered by end position (longest
+// pattern first for equal ends). Returns the number written
+int findAllPatterns(const MultiPattern& matcher, const char text[], int length,
+                    PatternMatch matches[], int maxMatches);
+
+// Earliest-ending occurrence. Returns 1 if found, 0 otherwise
+int findFirstPattern(const MultiPattern& matcher, const char text[], int length, PatternMatch& match);
+
+// counts[p] = occurrences of pattern p (overlaps included); counts must hold
+// patternCount entries. Returns the total
+int countPatterns(const MultiPattern& matcher, const char text[], int length, int counts[]);
+
+#endif
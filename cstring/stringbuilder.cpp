@@ -0,0 +1,217 @@
+// String Builder
+// Author: Pranjul Gupta
+
+#include "stringbuilder.h"
+#include <climits>
+#include <cstring>
+
+// ==================== ARENA ====================
+
+struct ArenaBlock {
+    ArenaBlock* next;
+    char* end;
+    // Block memory follows the header
+};
+
+static const int ARENA_ALIGNMENT = 8;
+static const int MIN_BUILDER_CAPACITY = 15;  // 16 bytes with the terminator
+
+static char* blockStart(ArenaBlock* block) {
+    return (char*)(block + 1);
+}
+
+static void pushBlock(StringArena& arena, long long size) {
+    char* memory = new char[sizeof(ArenaBlock) + size];
+    ArenaBlock* block = (ArenaBlock*)memory;
+    block->next = arena.blocks;
+    block->end = memory + sizeof(ArenaBlock) + size;
+    arena.blocks = block;
+    arena.cursor = blockStart(block);
+    arena.limit = block->end;
+}
+
+void initArena(StringArena& arena, int blockSize) {
+    arena.blocks = nullptr;
+    arena.cursor = nullptr;
+    arena.limit = nullptr;
+    arena.blockSize = blockSize < 256 ? 256 : blockSize;
+}
+
+char* arenaAllocate(StringArena& arena, int size) {
+    if (size < 0) return nullptr;
+    long long rounded = ((long long)size + ARENA_ALIGNMENT - 1) & ~(long long)(ARENA_ALIGNMENT - 1);
+    if (arena.cursor == nullptr || rounded > arena.limit - arena.cursor) {
+        pushBlock(arena, rounded > arena.blockSize ? rounded : arena.blockSize);
+    }
+    char* result = arena.cursor;
+    arena.cursor += rounded;
+    return result;
+}
+
+void resetArena(StringArena& arena) {
+    if (arena.blocks == nullptr) return;
+    // Keep the oldest block and free the rest
+    while (arena.blocks->next != nullptr) {
+        ArenaBlock* block = arena.blocks;
+        arena.blocks = block->next;
+        delete[] (char*)block;
+    }
+    // An oversized first request made the oldest block larger than the
+    // default; swap it for a default-size one so reset doesn't pin it
+    if (arena.blocks->end - blockStart(arena.blocks) > arena.blockSize) {
+        delete[] (char*)arena.blocks;
+        arena.blocks = nullptr;
+        pushBlock(arena, arena.blockSize);
+        return;
+    }
+    arena.cursor = blockStart(arena.blocks);
+    arena.limit = arena.blocks->end;
+}
+
+void freeArena(StringArena& arena) {
+    while (arena.blocks != nullptr) {
+        ArenaBlock* block = arena.blocks;
+        arena.blocks = block->next;
+        delete[] (char*)block;
+    }
+    arena.cursor = nullptr;
+    arena.limit = nullptr;
+}
+
+// ==================== BUILDER ====================
+
+static void allocateBuffer(StringBuilder& builder, int capacity) {
+    builder.data = builder.arena ? arenaAllocate(*builder.arena, capacity + 1) : new char[capacity + 1];
+    builder.capacity = capacity;
+}
+
+void initBuilder(StringBuilder& builder, int initialCapacity) {
+    builder.arena = nullptr;
+    builder.length = 0;
+    allocateBuffer(builder, initialCapacity > MIN_BUILDER_CAPACITY ? initialCapacity : MIN_BUILDER_CAPACITY);
+    builder.data[0] = '\0';
+}
+
+void initBuilder(StringBuilder& builder, StringArena& arena, int initialCapacity) {
+    builder.arena = &arena;
+    builder.length = 0;
+    allocateBuffer(builder, initialCapacity > MIN_BUILDER_CAPACITY ? initialCapacity : MIN_BUILDER_CAPACITY);
+    builder.data[0] = '\0';
+}
+
+void freeBuilder(StringBuilder& builder) {
+    if (builder.arena == nullptr) delete[] builder.data;
+    builder.data = nullptr;
+    builder.length = 0;
+    builder.capacity = 0;
+}
+
+// True if the builder's buffer is the arena's latest allocation and the
+// block has room to extend it to capacity characters
+static bool growInArena(StringBuilder& builder, int capacity) {
+    StringArena& arena = *builder.arena;
+    long long oldSize = ((long long)builder.capacity + 1 + ARENA_ALIGNMENT - 1) & ~(long long)(ARENA_ALIGNMENT - 1);
+    if (builder.data + oldSize != arena.cursor) return false;
+    long long newSize = ((long long)capacity + 1 + ARENA_ALIGNMENT - 1) & ~(long long)(ARENA_ALIGNMENT - 1);
+    if (newSize - oldSize > arena.limit - arena.cursor) return false;
+    arena.cursor += newSize - oldSize;
+    builder.capacity = (int)(newSize - 1);
+    return true;
+}
+
+int reserveBuilder(StringBuilder& builder, int capacity) {
+    if (capacity <= builder.capacity) return 1;
+    if (capacity == INT_MAX) return 0;  // No room for the terminator
+    long long grown = (long long)builder.capacity * 2 + 1;  // Geometric growth
+    if (grown < capacity) grown = capacity;
+    if (grown > INT_MAX - 1) grown = INT_MAX - 1;
+    if (builder.arena && growInArena(builder, (int)grown)) return 1;
+
+    char* old = builder.data;
+    allocateBuffer(builder, (int)grown);
+    memcpy(builder.data, old, builder.length + 1);
+    if (builder.arena == nullptr) delete[] old;
+    return 1;
+}
+
+int builderAppend(StringBuilder& builder, StringView text) {
+    if (text.length > INT_MAX - 1 - builder.length) return 0;
+    // text may point into the builder; growing can move or free that storage
+    long long aliasOffset = -1;
+    if (text.data >= builder.data && text.data <= builder.data + builder.capacity) {
+        aliasOffset = text.data - builder.data;
+    }
+    if (!reserveBuilder(builder, builder.length + text.length)) return 0;
+    if (aliasOffset >= 0) text.data = builder.data + aliasOffset;
+    memcpy(builder.data + builder.length, text.data, text.length);
+    builder.length += text.length;
+    builder.data[builder.length] = '\0';
+    return 1;
+}
+
+int builderAppend(StringBuilder& builder, const char text[]) {
+    return builderAppend(builder, makeView(text));
+}
+
+int builderAppendChar(StringBuilder& builder, char ch) {
+    if (builder.length == builder.capacity && !reserveBuilder(builder, builder.length + 1)) return 0;
+    builder.data[builder.length++] = ch;
+    builder.data[builder.length] = '\0';
+    return 1;
+}
+
+// Numbers are formatted straight into the buffer after reserving the longest form
+static int reserveNumber(StringBuilder& builder) {
+    if (builder.length > INT_MAX - NUMBER_BUFFER_SIZE) return 0;
+    return reserveBuilder(builder, builder.length + NUMBER_BUFFER_SIZE - 1);
+}
+
+int builderAppendInt(StringBuilder& builder, long long value) {
+    if (!reserveNumber(builder)) return 0;
+    builder.length += formatInt64(value, builder.data + builder.length);
+    return 1;
+}
+
+int builderAppendDouble(StringBuilder& builder, double value) {
+    if (!reserveNumber(builder)) return 0;
+    builder.length += formatDouble(value, builder.data + builder.length);
+    return 1;
+}
+
+int builderAppendRepeat(StringBuilder& builder, char ch, int count) {
+    if (count <= 0) return 1;
+    if (count > INT_MAX - 1 - builder.length) return 0;
+    if (!reserveBuilder(builder, builder.length + count)) return 0;
+    memset(builder.data + builder.length, ch, count);
+    builder.length += count;
+    builder.data[builder.length] = '\0';
+    return 1;
+}
+
+int builderInsert(StringBuilder& builder, int pos, StringView text) {
+    if (pos < 0 || pos > builder.length) return 0;
+    if (text.length > INT_MAX - 1 - builder.length) return 0;
+    // text may point into the builder itself; copy it out before growing
+    if (text.data >= builder.data && text.data < builder.data + builder.capacity + 1) {
+        StringBuilder copy;
+        initBuilder(copy, text.length);
+        builderAppend(copy, text);
+        int ok = builderInsert(builder, pos, builderView(copy));
+        freeBuilder(copy);
+        return ok;
+    }
+    if (!reserveBuilder(builder, builder.length + text.length)) return 0;
+    memmove(builder.data + pos + text.length, builder.data + pos, builder.length - pos + 1);
+    memcpy(builder.data + pos, text.data, text.length);
+    builder.length += text.length;
+    return 1;
+}
+
+void builderClear(StringBuilder& builder) {
+    builder.length = 0;
+    builder.data[0] = '\0';
+}
+
+StringView builderView(const StringBuilder& builder) {
+    return makeView(builder.data, builder.length);
+}
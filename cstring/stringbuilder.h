@@ -0,0 +1,74 @@
+// String Builder
+// Author: Pranjul Gupta
+
+#ifndef STRINGBUILDER_H
+#define STRINGBUILDER_H
+
+#include "cstring.h"
+
+// ==================== ARENA ====================
+
+struct ArenaBlock;
+
+// Bump allocator for short-lived strings: allocation is a pointer increment
+// and everything is released at once by resetArena/freeArena
+struct StringArena {
+    ArenaBlock* blocks;  // Most recent first
+    char* cursor;        // Next free byte in the current block
+    char* limit;         // End of the current block
+    int blockSize;       // Default size of new blocks
+};
+
+void initArena(StringArena& arena, int blockSize);
+
+// Returns size bytes (8-byte aligned) from the arena; requests larger than
+// the block size get a block of their own
+char* arenaAllocate(StringArena& arena, int size);
+
+// Forgets every allocation but keeps the first block for reuse
+void resetArena(StringArena& arena);
+
+// Releases all memory
+void freeArena(StringArena& arena);
+
+// ==================== BUILDER ====================
+
+// Growable, always null-terminated string. Capacity doubles when exceeded, so
+// appends are O(1) amortized. Heap builders own their buffer; arena builders
+// take memory from the arena and grow in place while they are its most
+// recent allocation.
+struct StringBuilder {
+    char* data;
+    int length;
+    int capacity;        // Characters that fit, excluding the terminator
+    StringArena* arena;  // nullptr for heap storage
+};
+
+void initBuilder(StringBuilder& builder, int initialCapacity);
+void initBuilder(StringBuilder& builder, StringArena& arena, int initialCapacity);
+
+// Releases heap storage (arena storage is reclaimed with the arena)
+void freeBuilder(StringBuilder& builder);
+
+// Ensures room for capacity characters. Returns 0 if it would exceed INT_MAX
+int reserveBuilder(StringBuilder& builder, int capacity);
+
+// Appends; each returns 1 on success, 0 if the length would overflow.
+// text may be a view of the builder's own contents
+int builderAppend(StringBuilder& builder, StringView text);
+int builderAppend(StringBuilder& builder, const char text[]);
+int builderAppendChar(StringBuilder& builder, char ch);
+int builderAppendInt(StringBuilder& builder, long long value);
+int builderAppendDouble(StringBuilder& builder, double value);  // Shortest round-trip form
+int builderAppendRepeat(StringBuilder& builder, char ch, int count);
+
+// Inserts text at pos (0..length). Returns 0 if pos is out of range
+int builderInsert(StringBuilder& builder, int pos, StringView text);
+
+// Empties the builder, keeping its capacity
+void builderClear(StringBuilder& builder);
+
+// View of the current contents (valid until the next modification)
+StringView builderView(const StringBuilder& builder);
+
+#endif
@@ -0,0 +1,321 @@
+// String Column
+// Author: Pranjul Gupta
+
+#include "stringcolumn.h"
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define STRINGCOLUMN_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const int MIN_COUNT_CAPACITY = 16;
+static const uint32_t MIN_BYTE_CAPACITY = 256;
+static const uint32_t MAX_COLUMN_BYTES = UINT32_MAX;
+
+// ==================== STORAGE ====================
+
+static void releaseStorage(StringColumn& column) {
+    if (column.mapping != nullptr) {
+#ifdef STRINGCOLUMN_MMAP
+        munmap(column.mapping, column.mappingSize);
+#else
+        delete[] (char*)column.mapping;
+#endif
+    } else {
+        delete[] column.bytes;
+        delete[] column.offsets;
+    }
+    column.mapping = nullptr;
+    column.mappingSize = 0;
+    column.bytes = nullptr;
+    column.offsets = nullptr;
+}
+
+void initColumn(StringColumn& column, int countCapacity, uint32_t byteCapacity) {
+    column.countCapacity = countCapacity < MIN_COUNT_CAPACITY ? MIN_COUNT_CAPACITY : countCapacity;
+    column.byteCapacity = byteCapacity < MIN_BYTE_CAPACITY ? MIN_BYTE_CAPACITY : byteCapacity;
+    column.bytes = new char[column.byteCapacity];
+    column.offsets = new uint32_t[column.countCapacity + 1];
+    column.offsets[0] = 0;
+    column.count = 0;
+    column.mapping = nullptr;
+    column.mappingSize = 0;
+}
+
+void freeColumn(StringColumn& column) {
+    releaseStorage(column);
+    column.count = 0;
+    column.countCapacity = 0;
+    column.byteCapacity = 0;
+}
+
+void clearColumn(StringColumn& column) {
+    column.count = 0;
+    column.offsets[0] = 0;
+}
+
+static uint32_t usedBytes(const StringColumn& column) {
+    return column.offsets[column.count];
+}
+
+// Copies a mapped column to heap arrays so it can grow
+static void detachMapping(StringColumn& column) {
+    uint32_t used = usedBytes(column);
+    int countCapacity = std::max(column.count, MIN_COUNT_CAPACITY);
+    uint32_t byteCapacity = std::max(used, MIN_BYTE_CAPACITY);
+    char* bytes = new char[byteCapacity];
+    uint32_t* offsets = new uint32_t[(size_t)countCapacity + 1];
+    memcpy(bytes, column.bytes, used);
+    memcpy(offsets, column.offsets, ((size_t)column.count + 1) * sizeof(uint32_t));
+    releaseStorage(column);
+    column.bytes = bytes;
+    column.offsets = offsets;
+    column.countCapacity = countCapacity;
+    column.byteCapacity = byteCapacity;
+}
+
+// Ensures room for the given totals. The offset and byte arrays grow
+// independently and geometrically, so adding strings never copies the bytes
+static int reserveColumn(StringColumn& column, long long strings, long long byteCount) {
+    if (strings > INT_MAX - 1 || byteCount > MAX_COLUMN_BYTES) return 0;
+    if (column.mapping != nullptr) detachMapping(column);
+    if (strings > column.countCapacity) {
+        long long capacity = std::min(std::max(strings, (long long)column.countCapacity * 2), (long long)INT_MAX - 1);
+        uint32_t* offsets = new uint32_t[(size_t)capacity + 1];
+        memcpy(offsets, column.offsets, ((size_t)column.count + 1) * sizeof(uint32_t));
+        delete[] column.offsets;
+        column.offsets = offsets;
+        column.countCapacity = (int)capacity;
+    }
+    if (byteCount > column.byteCapacity) {
+        long long capacity = std::min(std::max(byteCount, (long long)column.byteCapacity * 2), (long long)MAX_COLUMN_BYTES);
+        char* bytes = new char[(size_t)capacity];
+        memcpy(bytes, column.bytes, usedBytes(column));
+        delete[] column.bytes;
+        column.bytes = bytes;
+        column.byteCapacity = (uint32_t)capacity;
+    }
+    return 1;
+}
+
+// Offset of text within the column's bytes, or -1 if it points elsewhere
+static long long aliasOffset(const StringColumn& column, StringView text) {
+    if (text.length == 0 || text.data < column.bytes || text.data >= column.bytes + usedBytes(column)) return -1;
+    return text.data - column.bytes;
+}
+
+// ==================== BUILDING ====================
+
+int columnAppend(StringColumn& column, StringView text) {
+    long long alias = aliasOffset(column, text);
+    if (!reserveColumn(column, (long long)column.count + 1, (long long)usedBytes(column) + text.length)) return 0;
+    if (alias >= 0) text.data = column.bytes + alias;  // Storage may have moved
+    uint32_t used = usedBytes(column);
+    memcpy(column.bytes + used, text.data, text.length);
+    column.offsets[column.count + 1] = used + (uint32_t)text.length;
+    column.count++;
+    return 1;
+}
+
+int columnAppendSplit(StringColumn& column, StringView text, char delimiter) {
+    // Room for every byte of text up front: the bytes then never move while
+    // tokens (which may point into the column) are appended
+    long long alias = aliasOffset(column, text);
+    if (!reserveColumn(column, column.count, (long long)usedBytes(column) + text.length)) return 0;
+    if (alias >= 0) text.data = column.bytes + alias;
+    int added = 0;
+    int start = 0;
+    while (start < text.length) {
+        StringView rest = subview(text, start, text.length - start);
+        int end = findChar(rest, delimiter);
+        int tokenLength = end < 0 ? rest.length : end;
+        if (tokenLength > 0) {
+            if (!columnAppend(column, subview(rest, 0, tokenLength))) break;
+            added++;
+        }
+        start += tokenLength + 1;
+    }
+    return added;
+}
+
+StringView columnGet(const StringColumn& column, int index) {
+    if (index < 0 || index >= column.count) return makeView(column.bytes, 0);
+    return makeView(column.bytes + column.offsets[index], (int)(column.offsets[index + 1] - column.offsets[index]));
+}
+
+// ==================== SORT AND DEDUP ====================
+
+struct SortKey {
+    uint64_t prefix;  // First 8 bytes, big-endian, in stringCompare order
+    int length;
+    int index;
+};
+
+// Bytes compare as signed char in stringCompare; flipping the top bit makes
+// that an unsigned order. Missing bytes are 0, so a proper prefix never sorts
+// after the longer string (ties are settled by the full comparison)
+static uint64_t prefixKey(StringView text) {
+    uint64_t key = 0;
+    int n = text.length < 8 ? text.length : 8;
+    for (int i = 0; i < 8; i++) {
+        key <<= 8;
+        if (i < n) key |= (uint8_t)((uint8_t)text.data[i] ^ 0x80);
+    }
+    return key;
+}
+
+void sortColumn(StringColumn& column) {
+    if (column.count < 2) return;
+    std::vector<SortKey> keys(column.count);
+    for (int i = 0; i < column.count; i++) {
+        StringView text = columnGet(column, i);
+        keys[i].prefix = prefixKey(text);
+        keys[i].length = text.length;
+        keys[i].index = i;
+    }
+    std::sort(keys.begin(), keys.end(), [&column](const SortKey& a, const SortKey& b) {
+        if (a.prefix != b.prefix) return a.prefix < b.prefix;
+        // With equal keys, a string of at most 8 bytes is a prefix of the other
+        int order = (a.length <= 8 || b.length <= 8) ? (a.length > b.length) - (a.length < b.length)
+                                                      : stringCompare(columnGet(column, a.index), columnGet(column, b.index));
+        return order != 0 ? order < 0 : a.index < b.index;
+    });
+
+    // Gather into fresh storage in sorted order
+    uint32_t byteCapacity = std::max(column.byteCapacity, 1u);
+    char* bytes = new char[byteCapacity];
+    uint32_t* offsets = new uint32_t[(size_t)column.countCapacity + 1];
+    uint32_t position = 0;
+    offsets[0] = 0;
+    for (int i = 0; i < column.count; i++) {
+        StringView text = columnGet(column, keys[i].index);
+        memcpy(bytes + position, text.data, text.length);
+        position += (uint32_t)text.length;
+        offsets[i + 1] = position;
+    }
+    int count = column.count, countCapacity = column.countCapacity;
+    releaseStorage(column);
+    column.bytes = bytes;
+    column.offsets = offsets;
+    column.count = count;
+    column.countCapacity = countCapacity;
+    column.byteCapacity = byteCapacity;
+}
+
+int dedupColumn(StringColumn& column) {
+    if (column.count < 2) return column.count;
+    int kept = 1;
+    uint32_t start = column.offsets[1];  // Original start of string i (offsets[i] may be rewritten)
+    for (int i = 1; i < column.count; i++) {
+        uint32_t end = column.offsets[i + 1];
+        StringView text = makeView(column.bytes + start, (int)(end - start));
+        if (!stringEquals(text, columnGet(column, kept - 1))) {
+            uint32_t position = column.offsets[kept];
+            memmove(column.bytes + position, text.data, text.length);
+            column.offsets[kept + 1] = position + (uint32_t)text.length;
+            kept++;
+        }
+        start = end;
+    }
+    column.count = kept;
+    return kept;
+}
+
+// ==================== FILES ====================
+
+static const uint32_t COLUMN_MAGIC = 0x4C4F4353;  // "SCOL" in little-endian
+static const uint32_t COLUMN_VERSION = 1;
+
+struct ColumnFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+    uint32_t byteLength;
+};
+
+int saveColumn(const StringColumn& column, const char path[]) {
+    FILE* file = fopen(path, "wb");
+    if (file == nullptr) return 0;
+    ColumnFileHeader header = {COLUMN_MAGIC, COLUMN_VERSION, (uint32_t)column.count, usedBytes(column)};
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+             fwrite(column.offsets, sizeof(uint32_t), (size_t)column.count + 1, file) == (size_t)column.count + 1 &&
+             fwrite(column.bytes, 1, header.byteLength, file) == header.byteLength;
+    if (fclose(file) != 0) ok = 0;
+    return ok;
+}
+
+// Checks the header and offsets of a file image and points column into it
+static int attachImage(StringColumn& column, char* image, size_t size) {
+    ColumnFileHeader header;
+    if (size < sizeof(header)) return 0;
+    memcpy(&header, image, sizeof(header));
+    if (header.magic != COLUMN_MAGIC || header.version != COLUMN_VERSION || header.count > (uint32_t)INT_MAX - 1) {
+        return 0;
+    }
+    size_t offsetBytes = ((size_t)header.count + 1) * sizeof(uint32_t);
+    if (size != sizeof(header) + offsetBytes + header.byteLength) return 0;
+    uint32_t* offsets = (uint32_t*)(image + sizeof(header));
+    if (offsets[0] != 0 || offsets[header.count] != header.byteLength) return 0;
+    for (uint32_t i = 0; i < header.count; i++) {
+        if (offsets[i] > offsets[i + 1]) return 0;
+    }
+    column.offsets = offsets;
+    column.bytes = image + sizeof(header) + offsetBytes;
+    column.count = (int)header.count;
+    column.countCapacity = (int)header.count;
+    column.byteCapacity = header.byteLength;
+    return 1;
+}
+
+int mapColumn(StringColumn& column, const char path[]) {
+    column.mapping = nullptr;
+    column.mappingSize = 0;
+#ifdef STRINGCOLUMN_MMAP
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return 0;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(ColumnFileHeader)) {
+        close(fd);
+        return 0;
+    }
+    size_t size = (size_t)info.st_size;
+    // Private and writable: in-place edits (e.g. toLowerCasePacked) are
+    // copy-on-write and never reach the file
+    void* image = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (image == MAP_FAILED) return 0;
+    if (!attachImage(column, (char*)image, size)) {
+        munmap(image, size);
+        return 0;
+    }
+#else
+    FILE* file = fopen(path, "rb");
+    if (file == nullptr) return 0;
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (length < (long)sizeof(ColumnFileHeader)) {
+        fclose(file);
+        return 0;
+    }
+    size_t size = (size_t)length;
+    char* image = new char[size];
+    int ok = fread(image, 1, size, file) == size;
+    fclose(file);
+    if (!ok || !attachImage(column, image, size)) {
+        delete[] image;
+        return 0;
+    }
+#endif
+    column.mapping = image;
+    column.mappingSize = size;
+    return 1;
+}
@@ -0,0 +1,73 @@
+// String Column
+// Author: Pranjul Gupta
+
+#ifndef STRINGCOLUMN_H
+#define STRINGCOLUMN_H
+
+#include "cstring.h"
+#include <cstddef>
+
+// Strings stored back to back in one buffer with a table of uint32_t offsets:
+// string i is bytes[offsets[i], offsets[i + 1]). Unlike char tokens[][100]
+// there is no per-string padding or length limit, and scanning the column
+// reads consecutive memory. bytes and offsets can be passed straight to the
+// packed batch functions (toLowerCasePacked, unpackViews). Strings are not
+// null-terminated and may contain any byte. A column holds up to 4 GB of
+// string bytes.
+struct StringColumn {
+    char* bytes;
+    uint32_t* offsets;      // count + 1 entries, offsets[0] == 0
+    int count;
+    uint32_t byteCapacity;
+    int countCapacity;
+    void* mapping;          // File mapping holding bytes and offsets, or nullptr
+    size_t mappingSize;
+};
+
+// ==================== BUILDING ====================
+
+void initColumn(StringColumn& column, int countCapacity, uint32_t byteCapacity);
+
+// Releases the storage or file mapping
+void freeColumn(StringColumn& column);
+
+// Removes every string but keeps the storage
+void clearColumn(StringColumn& column);
+
+// Appends a copy of text (which may point into the column itself). Returns 1,
+// or 0 if the column would exceed 4 GB of bytes or INT_MAX strings
+int columnAppend(StringColumn& column, StringView text);
+
+// Appends the non-empty tokens of text split at delimiter, as splitString
+// does but without a token limit or length cap. Returns the tokens appended
+int columnAppendSplit(StringColumn& column, StringView text, char delimiter);
+
+// View of string index (empty if out of range). Valid until the column changes
+StringView columnGet(const StringColumn& column, int index);
+
+// ==================== SORT AND DEDUP ====================
+
+// Sorts into stringCompare order; equal strings keep their relative order.
+// Strings are ordered by an 8-byte prefix key first, so most comparisons
+// never touch the string bytes
+void sortColumn(StringColumn& column);
+
+// Removes adjacent duplicates in place, so after sortColumn every string is
+// unique. Returns the new count
+int dedupColumn(StringColumn& column);
+
+// ==================== FILES ====================
+// Layout: a 16-byte header (magic "SCOL", version, count, byte length), the
+// count + 1 offsets, then the bytes, all in native byte order. A mapped file
+// is used in place without parsing or copying.
+
+// Writes the column to path. Returns 1 on success, 0 on I/O error
+int saveColumn(const StringColumn& column, const char path[]);
+
+// Initializes column from a file written by saveColumn, memory-mapping it
+// where the platform supports it (otherwise reading it). Changes are private
+// to the process and never written back; appending or sorting first copies
+// the column to the heap. Returns 0 if the file is missing or malformed
+int mapColumn(StringColumn& column, const char path[]);
+
+#endif
@@ -0,0 +1,167 @@
+// Lazy Tokenizer
+// Author: Pranjul Gupta
+
+#include "tokenizer.h"
+#include <cstring>
+
+// ==================== SETUP ====================
+
+static void initCommon(Tokenizer& tokenizer, StringView text, StringView delimiter, int mode) {
+    tokenizer.text = text;
+    tokenizer.delimiter = delimiter;
+    tokenizer.delimiterChar = delimiter.length > 0 ? delimiter.data[0] : '\0';
+    tokenizer.position = 0;
+    tokenizer.mode = mode;
+    tokenizer.skipEmpty = 0;
+    tokenizer.finished = 0;
+}
+
+void initTokenizer(Tokenizer& tokenizer, StringView text, char delimiter) {
+    initCommon(tokenizer, text, makeView(&delimiter, 1), SPLIT_CHAR);
+    tokenizer.delimiter.data = nullptr;  // Only delimiterChar is used
+}
+
+void initStringTokenizer(Tokenizer& tokenizer, StringView text, StringView delimiter) {
+    initCommon(tokenizer, text, delimiter, SPLIT_STRING);
+}
+
+void initSetTokenizer(Tokenizer& tokenizer, StringView text, StringView delimiters) {
+    initCommon(tokenizer, text, delimiters, SPLIT_ANY);
+}
+
+void initCsvTokenizer(Tokenizer& tokenizer, StringView text, char delimiter) {
+    initCommon(tokenizer, text, makeView(&delimiter, 1), SPLIT_CSV);
+    tokenizer.delimiter.data = nullptr;
+    tokenizer.finished = text.length == 0;  // No records in empty input
+}
+
+// ==================== DELIMITER SEARCH ====================
+
+// Offset (relative to rest) of the next delimiter and its length, or -1
+static int findDelimiter(const Tokenizer& tokenizer, StringView rest, int& delimiterLength) {
+    delimiterLength = 1;
+    switch (tokenizer.mode) {
+        case SPLIT_CHAR:
+            return findChar(rest, tokenizer.delimiterChar);
+        case SPLIT_ANY:
+            return findAnyChar(rest, tokenizer.delimiter);
+        case SPLIT_STRING: {
+            // Delimiters are short: locate the first byte, then confirm the rest
+            StringView delimiter = tokenizer.delimiter;
+            delimiterLength = delimiter.length;
+            if (delimiter.length == 0) return -1;
+            int searched = 0;
+            while (searched <= rest.length - delimiter.length) {
+                int hit = findChar(subview(rest, searched, rest.length - searched), delimiter.data[0]);
+                if (hit < 0) return -1;
+                int at = searched + hit;
+                if (at > rest.length - delimiter.length) return -1;
+                if (memcmp(rest.data + at + 1, delimiter.data + 1, delimiter.length - 1) == 0) return at;
+                searched = at + 1;
+            }
+            return -1;
+        }
+    }
+    return -1;
+}
+
+// ==================== CSV ====================
+
+static int nextCsvField(Tokenizer& tokenizer, Token& token) {
+    const char* data = tokenizer.text.data;
+    int length = tokenizer.text.length;
+    int start = tokenizer.position;
+    char terminators[2] = {tokenizer.delimiterChar, '\n'};
+    int end;        // One past the field's last byte
+    int resume;     // Where scanning continues after the field
+
+    token.quoted = 0;
+    if (start < length && data[start] == '"') {
+        // Quoted: find the closing quote, stepping over "" escapes
+        int i = start + 1;
+        for (;;) {
+            int hit = findChar(makeView(data + i, length - i), '"');
+            if (hit < 0) {
+                i = length;  // Unterminated: take the rest of the text
+                break;
+            }
+            i += hit;
+            if (i + 1 < length && data[i + 1] == '"') {
+                i += 2;
+                continue;
+            }
+            break;
+        }
+        token.quoted = 1;
+        token.view = makeView(data + start + 1, i - start - 1);
+        token.offset = start + 1;
+        // Anything between the closing quote and the terminator is ignored
+        int after = i < length ? i + 1 : length;
+        int hit = findAnyChar(makeView(data + after, length - after), makeView(terminators, 2));
+        resume = hit < 0 ? length : after + hit;
+        end = -1;
+    } else {
+        int hit = findAnyChar(makeView(data + start, length - start), makeView(terminators, 2));
+        resume = hit < 0 ? length : start + hit;
+        end = resume;
+        if (end > start && end < length && data[end] == '\n' && data[end - 1] == '\r') end--;  // CRLF
+        if (hit < 0 && end > start && data[end - 1] == '\r') end--;
+        token.view = makeView(data + start, end - start);
+        token.offset = start;
+    }
+
+    if (resume >= length) {
+        token.endOfRecord = 1;
+        tokenizer.finished = 1;
+        tokenizer.position = length;
+    } else if (data[resume] == '\n') {
+        token.endOfRecord = 1;
+        tokenizer.position = resume + 1;
+        if (tokenizer.position == length) tokenizer.finished = 1;  // Trailing newline ends the input
+    } else {
+        token.endOfRecord = 0;
+        tokenizer.position = resume + 1;
+    }
+    return 1;
+}
+
+// ==================== ITERATION ====================
+
+int nextToken(Tokenizer& tokenizer, Token& token) {
+    while (!tokenizer.finished) {
+        if (tokenizer.mode == SPLIT_CSV) {
+            nextCsvField(tokenizer, token);
+        } else {
+            int start = tokenizer.position;
+            StringView rest = subview(tokenizer.text, start, tokenizer.text.length - start);
+            int delimiterLength;
+            int hit = findDelimiter(tokenizer, rest, delimiterLength);
+            int tokenLength = hit < 0 ? rest.length : hit;
+            token.view = subview(rest, 0, tokenLength);
+            token.offset = start;
+            token.quoted = 0;
+            token.endOfRecord = hit < 0;
+            if (hit < 0) {
+                tokenizer.finished = 1;
+                tokenizer.position = tokenizer.text.length;
+            } else {
+                tokenizer.position = start + hit + delimiterLength;
+            }
+        }
+        if (!tokenizer.skipEmpty || token.view.length > 0) return 1;
+    }
+    return 0;
+}
+
+int unescapeCsvField(const Token& token, char out[]) {
+    int j = 0;
+    for (int i = 0; i < token.view.length; i++) {
+        out[j++] = token.view.data[i];
+        if (token.quoted && token.view.data[i] == '"' && i + 1 < token.view.length &&
+            token.view.data[i + 1] == '"') {
+            i++;  // Skip the second quote of an escape
+        }
+    }
+    out[j] = '\0';
+    return j;
+}
@@ -0,0 +1,57 @@
+// Lazy Tokenizer
+// Author: Pranjul Gupta
+
+#ifndef TOKENIZER_H
+#define TOKENIZER_H
+
+#include "cstring.h"
+
+// Splits text into tokens on demand without copying or allocating: each
+// token is a view into the original text, of any length. Delimiters are
+// located with the library's vectorized search primitives.
+
+enum TokenizerMode {
+    SPLIT_CHAR = 0,    // One delimiter byte
+    SPLIT_STRING = 1,  // A multi-byte delimiter string
+    SPLIT_ANY = 2,     // Any byte from a delimiter set
+    SPLIT_CSV = 3      // RFC 4180 fields: quoting, "" escapes, CRLF/LF records
+};
+
+struct Tokenizer {
+    StringView text;
+    StringView delimiter;  // Delimiter byte, string or set
+    char delimiterChar;
+    int position;          // Offset where the next token starts
+    int mode;
+    int skipEmpty;         // 1 to skip empty tokens (as splitString does)
+    int finished;
+};
+
+struct Token {
+    StringView view;   // Token bytes (for quoted CSV fields, between the quotes)
+    int offset;        // Offset of view.data within the text
+    int quoted;        // CSV: 1 if the field was quoted ("" escapes remain in view)
+    int endOfRecord;   // CSV: 1 if this is the last field of its record
+};
+
+// Split on one byte. Adjacent delimiters give empty tokens unless skipEmpty
+void initTokenizer(Tokenizer& tokenizer, StringView text, char delimiter);
+
+// Split on a delimiter string (e.g. ", " or "::")
+void initStringTokenizer(Tokenizer& tokenizer, StringView text, StringView delimiter);
+
+// Split on any byte from a set (e.g. " \t\n")
+void initSetTokenizer(Tokenizer& tokenizer, StringView text, StringView delimiters);
+
+// CSV fields separated by delimiter (usually ','), records by LF or CRLF.
+// Quoted fields may contain delimiters, newlines and "" escapes
+void initCsvTokenizer(Tokenizer& tokenizer, StringView text, char delimiter);
+
+// Produces the next token. Returns 1 if one was produced, 0 at the end
+int nextToken(Tokenizer& tokenizer, Token& token);
+
+// Copies a token to out, turning "" into " for quoted CSV fields, and adds a
+// terminator. out must hold token.view.length + 1 bytes. Returns the length
+int unescapeCsvField(const Token& token, char out[]);
+
+#endif
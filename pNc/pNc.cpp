@@ -1,22 +1,50 @@
 #include "pNc.h"
+#include <climits>
+
+// 0! .. 12!, the factorials that fit in a 32-bit int
+static const int factorials[] = {
+	1, 1, 2, 6, 24, 120, 720, 5040, 40320, 362880, 3628800, 39916800, 479001600
+};
 
 int factorial(int n) {
-	if (n <= 1) {
-		return 1;
+	if (n < 0) {
+		return 0;
 	}
-	else {
-		return n * factorial(n-1);
+	if (n > 12) {
+		return -1;
 	}
+	return factorials[n];
 }
 
+// n * (n-1) * ... * (n-r+1), without computing either factorial
 int permutation(int n,int r) {
-	return factorial(n)/factorial(r)*factorial(n-r);
+	if (r < 0 || n < 0 || r > n) {
+		return 0;
+	}
+	long long result = 1;
+	for (int i = n; i > n - r; i--) {
+		result *= i;
+		if (result > INT_MAX) {
+			return -1;
+		}
+	}
+	return (int)result;
 }
 
+// Multiplicative formula over min(r, n-r) terms; every partial product is exact
 int combination(int n,int r) {
-	return factorial(n)/factorial(n-r);
+	if (r < 0 || n < 0 || r > n) {
+		return 0;
+	}
+	if (r > n - r) {
+		r = n - r;
+	}
+	long long result = 1;
+	for (int i = 0; i < r; i++) {
+		result = result * (n - i) / (i + 1);
+		if (result > INT_MAX) {
+			return -1;
+		}
+	}
+	return (int)result;
 }
-
-
-
-
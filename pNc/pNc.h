@@ -1,13 +1,18 @@
-#ifndef pNc
+#ifndef PNC_H
 
-#define pNc
+#define PNC_H
 
 // Helper Functions
+
+// n! for 0 <= n <= 12 (table lookup); returns -1 if n! overflows int
 int factorial(int n);
 
 // Main Functions
-int permutation(int n);
 
-int combination(int n);
+// nPr = n! / (n-r)!; returns -1 on overflow
+int permutation(int n, int r);
+
+// nCr = n! / (r! * (n-r)!); returns -1 on overflow
+int combination(int n, int r);
 
 #endif
@@ -0,0 +1,280 @@
+#include "bignum.h"
+#include <algorithm>
+
+typedef std::vector<uint32_t> Limbs;
+
+// Operands shorter than this (in limbs) use schoolbook multiplication
+static const int KARATSUBA_THRESHOLD = 32;
+
+// ==================== LIMB HELPERS ====================
+
+static void trim(Limbs& a) {
+    while (!a.empty() && a.back() == 0) a.pop_back();
+}
+
+// Length of a[0..n) without leading zero limbs
+static int significant(const uint32_t* a, int n) {
+    while (n > 0 && a[n - 1] == 0) n--;
+    return n;
+}
+
+// result[shift..] += x, growing result as needed
+static void addShifted(Limbs& result, const Limbs& x, int shift) {
+    if (x.empty()) return;
+    if ((int)result.size() < shift + (int)x.size() + 1) result.resize(shift + x.size() + 1, 0);
+    uint64_t carry = 0;
+    size_t i = 0;
+    for (; i < x.size(); i++) {
+        uint64_t sum = (uint64_t)result[shift + i] + x[i] + carry;
+        result[shift + i] = (uint32_t)sum;
+        carry = sum >> 32;
+    }
+    for (size_t j = shift + i; carry != 0; j++) {
+        if (j == result.size()) result.push_back(0);
+        uint64_t sum = (uint64_t)result[j] + carry;
+        result[j] = (uint32_t)sum;
+        carry = sum >> 32;
+    }
+}
+
+// a -= b, requires a >= b
+static void subtractInPlace(Limbs& a, const Limbs& b) {
+    int64_t borrow = 0;
+    for (size_t i = 0; i < a.size(); i++) {
+        int64_t diff = (int64_t)a[i] - (i < b.size() ? b[i] : 0) - borrow;
+        borrow = diff < 0 ? 1 : 0;
+        a[i] = (uint32_t)(diff + (borrow << 32));
+        if (i >= b.size() && borrow == 0) break;
+    }
+    trim(a);
+}
+
+// a[0..na) + b[0..nb)
+static Limbs addLimbs(const uint32_t* a, int na, const uint32_t* b, int nb) {
+    if (na < nb) {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+    Limbs result(na + 1, 0);
+    uint64_t carry = 0;
+    for (int i = 0; i < na; i++) {
+        uint64_t sum = (uint64_t)a[i] + (i < nb ? b[i] : 0) + carry;
+        result[i] = (uint32_t)sum;
+        carry = sum >> 32;
+    }
+    result[na] = (uint32_t)carry;
+    trim(result);
+    return result;
+}
+
+static Limbs schoolbook(const uint32_t* a, int na, const uint32_t* b, int nb) {
+    Limbs result(na + nb, 0);
+    for (int i = 0; i < na; i++) {
+        uint64_t carry = 0;
+        uint64_t ai = a[i];
+        for (int j = 0; j < nb; j++) {
+            uint64_t cur = ai * b[j] + result[i + j] + carry;
+            result[i + j] = (uint32_t)cur;
+            carry = cur >> 32;
+        }
+        result[i + nb] = (uint32_t)carry;
+    }
+    trim(result);
+    return result;
+}
+
+// Karatsuba: with a = a1 B^m + a0 and b = b1 B^m + b0,
+//   a b = z2 B^2m + ((a0 + a1)(b0 + b1) - z0 - z2) B^m + z0
+static Limbs karatsuba(const uint32_t* a, int na, const uint32_t* b, int nb) {
+    na = significant(a, na);
+    nb = significant(b, nb);
+    if (na == 0 || nb == 0) return Limbs();
+    if (na < nb) {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+    if (nb < KARATSUBA_THRESHOLD) return schoolbook(a, na, b, nb);
+
+    int m = na / 2;
+    if (nb <= m) {
+        // Unbalanced: split only a and multiply each half by the whole of b
+        Limbs low = karatsuba(a, m, b, nb);
+        Limbs high = karatsuba(a + m, na - m, b, nb);
+        addShifted(low, high, m);
+        trim(low);
+        return low;
+    }
+
+    Limbs z0 = karatsuba(a, m, b, m);
+    Limbs z2 = karatsuba(a + m, na - m, b + m, nb - m);
+    Limbs sumA = addLimbs(a, significant(a, m), a + m, na - m);
+    Limbs sumB = addLimbs(b, significant(b, m), b + m, nb - m);
+    Limbs z1 = karatsuba(sumA.data(), (int)sumA.size(), sumB.data(), (int)sumB.size());
+    subtractInPlace(z1, z0);
+    subtractInPlace(z1, z2);
+
+    Limbs result = z0;
+    addShifted(result, z1, m);
+    addShifted(result, z2, 2 * m);
+    trim(result);
+    return result;
+}
+
+// ==================== ARITHMETIC ====================
+
+BigInt bigFromUnsigned(unsigned long long value) {
+    BigInt result;
+    while (value != 0) {
+        result.limbs.push_back((uint32_t)value);
+        value >>= 32;
+    }
+    return result;
+}
+
+BigInt bigMultiply(const BigInt& a, const BigInt& b) {
+    BigInt result;
+    result.limbs = karatsuba(a.limbs.data(), (int)a.limbs.size(),
+                             b.limbs.data(), (int)b.limbs.size());
+    return result;
+}
+
+int bigCompare(const BigInt& a, const BigInt& b) {
+    if (a.limbs.size() != b.limbs.size()) return a.limbs.size() < b.limbs.size() ? -1 : 1;
+    for (size_t i = a.limbs.size(); i-- > 0;) {
+        if (a.limbs[i] != b.limbs[i]) return a.limbs[i] < b.limbs[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+int bigIsZero(const BigInt& value) {
+    return value.limbs.empty();
+}
+
+// Repeated division by 10^9, emitting nine digits per step
+std::string bigToString(const BigInt& value) {
+    if (value.limbs.empty()) return "0";
+    Limbs work = value.limbs;
+    std::vector<uint32_t> chunks;
+    while (!work.empty()) {
+        uint64_t remainder = 0;
+        for (size_t i = work.size(); i-- > 0;) {
+            uint64_t cur = (remainder << 32) | work[i];
+            work[i] = (uint32_t)(cur / 1000000000u);
+            remainder = cur % 1000000000u;
+        }
+        trim(work);
+        chunks.push_back((uint32_t)remainder);
+    }
+    std::string result = std::to_string(chunks.back());
+    for (size_t i = chunks.size() - 1; i-- > 0;) {
+        std::string part = std::to_string(chunks[i]);
+        result.append(9 - part.size(), '0');
+        result += part;
+    }
+    return result;
+}
+
+// ==================== EXACT COMBINATORICS ====================
+
+// Primes up to n (sieve of Eratosthenes)
+static std::vector<int> primesUpTo(int n) {
+    std::vector<int> primes;
+    if (n < 2) return primes;
+    std::vector<char> composite(n + 1, 0);
+    for (int i = 2; i <= n; i++) {
+        if (composite[i]) continue;
+        primes.push_back(i);
+        for (long long j = (long long)i * i; j <= n; j += i) composite[j] = 1;
+    }
+    return primes;
+}
+
+// Legendre's formula: exponent of prime p in n! is sum of floor(n / p^i)
+static int legendreExponent(int n, int p) {
+    int exponent = 0;
+    long long power = p;
+    while (power <= n) {
+        exponent += (int)(n / power);
+        power *= p;
+    }
+    return exponent;
+}
+
+// Balanced product tree over factors[lo, hi), so large multiplications are
+// between similar-sized operands where Karatsuba pays off
+static Limbs productTree(const std::vector<uint32_t>& factors, int lo, int hi) {
+    if (hi - lo <= 16) {
+        Limbs result(1, 1);
+        for (int i = lo; i < hi; i++) {
+            uint64_t carry = 0;
+            for (size_t j = 0; j < result.size(); j++) {
+                uint64_t cur = (uint64_t)result[j] * factors[i] + carry;
+                result[j] = (uint32_t)cur;
+                carry = cur >> 32;
+            }
+            if (carry != 0) result.push_back((uint32_t)carry);
+        }
+        trim(result);
+        return result;
+    }
+    int mid = lo + (hi - lo) / 2;
+    Limbs left = productTree(factors, lo, mid);
+    Limbs right = productTree(factors, mid, hi);
+    return karatsuba(left.data(), (int)left.size(), right.data(), (int)right.size());
+}
+
+// Assembles prod p^e_p by binary powering: for each exponent bit from the top,
+// square the accumulator and multiply in the product of primes with that bit set
+static BigInt fromFactorization(const std::vector<int>& primes, const std::vector<int>& exponents) {
+    int maxExponent = 0;
+    for (size_t i = 0; i < exponents.size(); i++) {
+        if (exponents[i] > maxExponent) maxExponent = exponents[i];
+    }
+    BigInt result = bigFromUnsigned(1);
+    if (maxExponent == 0) return result;
+    int topBit = 0;
+    while ((maxExponent >> (topBit + 1)) != 0) topBit++;
+
+    std::vector<uint32_t> factors;
+    for (int bit = topBit; bit >= 0; bit--) {
+        result = bigMultiply(result, result);
+        factors.clear();
+        for (size_t i = 0; i < primes.size(); i++) {
+            if ((exponents[i] >> bit) & 1) factors.push_back((uint32_t)primes[i]);
+        }
+        if (factors.empty()) continue;
+        BigInt product;
+        product.limbs = productTree(factors, 0, (int)factors.size());
+        result = bigMultiply(result, product);
+    }
+    return result;
+}
+
+BigInt bigFactorial(int n) {
+    if (n < 0) return BigInt();
+    std::vector<int> primes = primesUpTo(n);
+    std::vector<int> exponents(primes.size());
+    for (size_t i = 0; i < primes.size(); i++) exponents[i] = legendreExponent(n, primes[i]);
+    return fromFactorization(primes, exponents);
+}
+
+BigInt bigPermutation(int n, int r) {
+    if (r > n || r < 0 || n < 0) return BigInt();
+    std::vector<int> primes = primesUpTo(n);
+    std::vector<int> exponents(primes.size());
+    for (size_t i = 0; i < primes.size(); i++) {
+        exponents[i] = legendreExponent(n, primes[i]) - legendreExponent(n - r, primes[i]);
+    }
+    return fromFactorization(primes, exponents);
+}
+
+BigInt bigCombination(int n, int r) {
+    if (r > n || r < 0 || n < 0) return BigInt();
+    std::vector<int> primes = primesUpTo(n);
+    std::vector<int> exponents(primes.size());
+    for (size_t i = 0; i < primes.size(); i++) {
+        int p = primes[i];
+        exponents[i] = legendreExponent(n, p) - legendreExponent(r, p) - legendreExponent(n - r, p);
+    }
+    return fromFactorization(primes, exponents);
+}
@@ -0,0 +1,46 @@
+#ifndef BIGNUM_H
+#define BIGNUM_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Arbitrary-precision non-negative integer for exact large counts.
+// Little-endian base-2^32 limbs with no leading zero limbs; zero has no limbs.
+struct BigInt {
+    std::vector<uint32_t> limbs;
+};
+
+// ==================== ARITHMETIC ====================
+
+// Converts a machine integer to a BigInt
+BigInt bigFromUnsigned(unsigned long long value);
+
+// Product a * b: schoolbook for small operands, Karatsuba above ~32 limbs
+BigInt bigMultiply(const BigInt& a, const BigInt& b);
+
+// Returns -1, 0 or 1 as a is less than, equal to or greater than b
+int bigCompare(const BigInt& a, const BigInt& b);
+
+// Returns 1 if value is zero, 0 otherwise
+int bigIsZero(const BigInt& value);
+
+// Decimal representation
+std::string bigToString(const BigInt& value);
+
+// ==================== EXACT COMBINATORICS ====================
+// Built from prime factorizations (Legendre's formula): each prime's exponent
+// is computed directly, primes sharing an exponent bit are multiplied with a
+// balanced product tree, and the result is assembled by repeated squaring.
+// Invalid arguments return zero.
+
+// Exact n!
+BigInt bigFactorial(int n);
+
+// Exact nPr = n! / (n-r)!
+BigInt bigPermutation(int n, int r);
+
+// Exact nCr = n! / (r! * (n-r)!)
+BigInt bigCombination(int n, int r);
+
+#endif
@@ -0,0 +1,168 @@
+#include "convolution.h"
+#include <climits>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+typedef std::complex<double> Complex;
+
+static const double PI = 3.14159265358979323846;
+
+// Below this many terms in the shorter operand direct convolution is faster
+static const int DIRECT_CONVOLUTION_THRESHOLD = 64;
+
+// Largest supported lattice size; keeps FFT buffers and int offsets in range
+static const long long MAX_LATTICE_SIZE = 1LL << 28;
+
+// ==================== FFT ====================
+
+// In-place iterative radix-2 FFT; size must be a power of two. Twiddles are
+// taken from a table filled with cos/sin per index rather than by repeated
+// multiplication, which would accumulate error over long transforms
+static void fft(std::vector<Complex>& data, const std::vector<Complex>& roots, bool inverse) {
+    int n = (int)data.size();
+    for (int i = 1, j = 0; i < n; i++) {
+        int bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) std::swap(data[i], data[j]);
+    }
+    for (int length = 2; length <= n; length <<= 1) {
+        int half = length >> 1;
+        int stride = n / length;
+        for (int start = 0; start < n; start += length) {
+            for (int k = 0; k < half; k++) {
+                Complex w = roots[k * stride];
+                if (inverse) w = std::conj(w);
+                Complex u = data[start + k];
+                Complex v = data[start + k + half] * w;
+                data[start + k] = u + v;
+                data[start + k + half] = u - v;
+            }
+        }
+    }
+    if (inverse) {
+        for (int i = 0; i < n; i++) data[i] /= n;
+    }
+}
+
+// Real convolution with one forward and one inverse transform: pack a and b
+// as real and imaginary parts of c, then Im(c * c) = 2 (a conv b)
+static void fftConvolve(const double a[], int na, const double b[], int nb, double result[]) {
+    int resultSize = na + nb - 1;
+    int n = 1;
+    while (n < resultSize) n <<= 1;
+    std::vector<Complex> roots(n / 2 > 0 ? n / 2 : 1);
+    for (int k = 0; k < n / 2; k++) {
+        double angle = -2.0 * PI * k / n;
+        roots[k] = Complex(cos(angle), sin(angle));
+    }
+    std::vector<Complex> data(n, Complex(0, 0));
+    for (int i = 0; i < na; i++) data[i].real(a[i]);
+    for (int i = 0; i < nb; i++) data[i].imag(b[i]);
+    fft(data, roots, false);
+    for (int i = 0; i < n; i++) data[i] *= data[i];
+    fft(data, roots, true);
+    for (int i = 0; i < resultSize; i++) {
+        double value = data[i].imag() * 0.5;
+        result[i] = value > 0 ? value : 0.0;  // Rounding can leave tiny negatives
+    }
+}
+
+static void directConvolve(const double a[], int na, const double b[], int nb, double result[]) {
+    for (int k = 0; k < na + nb - 1; k++) result[k] = 0;
+    for (int i = 0; i < na; i++) {
+        if (a[i] == 0) continue;
+        for (int j = 0; j < nb; j++) result[i + j] += a[i] * b[j];
+    }
+}
+
+bool convolvePmf(const double a[], int na, const double b[], int nb, double result[]) {
+    if (na <= 0 || nb <= 0) return false;
+    if (na < DIRECT_CONVOLUTION_THRESHOLD || nb < DIRECT_CONVOLUTION_THRESHOLD) {
+        directConvolve(a, na, b, nb, result);
+    } else {
+        fftConvolve(a, na, b, nb, result);
+    }
+    return true;
+}
+
+// ==================== LATTICE DISTRIBUTIONS ====================
+
+bool makeLatticeDistribution(LatticeDistribution& dist, const int values[],
+                             const double probabilities[], int size) {
+    dist.pmf = nullptr;
+    dist.size = 0;
+    dist.offset = 0;
+    if (size <= 0) return false;
+    int lo = values[0], hi = values[0];
+    for (int i = 0; i < size; i++) {
+        if (!(probabilities[i] >= 0)) return false;
+        if (values[i] < lo) lo = values[i];
+        if (values[i] > hi) hi = values[i];
+    }
+    long long span = (long long)hi - lo + 1;
+    if (span > MAX_LATTICE_SIZE) return false;
+    dist.size = (int)span;
+    dist.offset = lo;
+    dist.pmf = new double[dist.size]();
+    for (int i = 0; i < size; i++) dist.pmf[values[i] - lo] += probabilities[i];
+    return true;
+}
+
+void freeLatticeDistribution(LatticeDistribution& dist) {
+    delete[] dist.pmf;
+    dist.pmf = nullptr;
+    dist.size = 0;
+    dist.offset = 0;
+}
+
+bool convolveDistributions(LatticeDistribution& result, const LatticeDistribution& a,
+                           const LatticeDistribution& b) {
+    result.pmf = nullptr;
+    result.size = 0;
+    result.offset = 0;
+    if (a.size <= 0 || b.size <= 0) return false;
+    long long size = (long long)a.size + b.size - 1;
+    long long offset = (long long)a.offset + b.offset;
+    if (size > MAX_LATTICE_SIZE || offset < INT_MIN || offset + size - 1 > INT_MAX) return false;
+    result.size = (int)size;
+    result.offset = (int)offset;
+    result.pmf = new double[result.size];
+    convolvePmf(a.pmf, a.size, b.pmf, b.size, result.pmf);
+    return true;
+}
+
+// Binary powering from the top bit: square the running sum, then add one
+// more copy of dist wherever the bit of n is set
+bool convolutionPower(LatticeDistribution& result, const LatticeDistribution& dist, int n) {
+    result.pmf = nullptr;
+    result.size = 0;
+    result.offset = 0;
+    if (n < 1 || dist.size <= 0) return false;
+    long long size = (long long)n * (dist.size - 1) + 1;
+    long long offset = (long long)n * dist.offset;
+    if (size > MAX_LATTICE_SIZE || offset < INT_MIN || offset + size - 1 > INT_MAX) return false;
+
+    int topBit = 0;
+    while ((n >> (topBit + 1)) != 0) topBit++;
+    LatticeDistribution current;
+    current.size = dist.size;
+    current.offset = dist.offset;
+    current.pmf = new double[dist.size];
+    for (int i = 0; i < dist.size; i++) current.pmf[i] = dist.pmf[i];
+
+    for (int bit = topBit - 1; bit >= 0; bit--) {
+        LatticeDistribution next;
+        convolveDistributions(next, current, current);
+        freeLatticeDistribution(current);
+        current = next;
+        if ((n >> bit) & 1) {
+            convolveDistributions(next, current, dist);
+            freeLatticeDistribution(current);
+            current = next;
+        }
+    }
+    result = current;
+    return true;
+}
@@ -0,0 +1,39 @@
+#ifndef CONVOLUTION_H
+#define CONVOLUTION_H
+
+// Distributions of sums of independent integer-valued random variables.
+// Large inputs are convolved by FFT in O(n log n); small ones directly.
+// FFT results carry absolute (not relative) rounding error of about 1e-16
+// times the largest probability, so deep tails below that level read as 0.
+
+// PMF on a run of consecutive integers: P(X = offset + i) = pmf[i]
+struct LatticeDistribution {
+    double* pmf;
+    int size;
+    int offset;
+};
+
+// Builds a lattice PMF from the values[]/probabilities[] arrays used by
+// expectedValue(): gaps in the support become zeros and repeated values add up.
+// Probabilities are not normalized. Returns false if size <= 0, any
+// probability is negative or the support spans more than 2^28 integers
+bool makeLatticeDistribution(LatticeDistribution& dist, const int values[],
+                             const double probabilities[], int size);
+
+// Releases the distribution
+void freeLatticeDistribution(LatticeDistribution& dist);
+
+// result[k] = sum over i of a[i] * b[k - i]; result must hold na + nb - 1 values.
+// Returns false if na or nb <= 0
+bool convolvePmf(const double a[], int na, const double b[], int nb, double result[]);
+
+// Distribution of X + Y for independent X ~ a and Y ~ b
+bool convolveDistributions(LatticeDistribution& result, const LatticeDistribution& a,
+                           const LatticeDistribution& b);
+
+// Distribution of X1 + ... + Xn for n independent copies of dist, using
+// O(log n) convolutions (exponentiation by squaring). Returns false if n < 1
+// or the result would span more than 2^28 integers
+bool convolutionPower(LatticeDistribution& result, const LatticeDistribution& dist, int n);
+
+#endif
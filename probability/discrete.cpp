@@ -0,0 +1,132 @@
+#include "discrete.h"
+#include <algorithm>
+#include <cmath>
+
+bool initDiscreteDistribution(DiscreteDistribution& dist, const int values[],
+                              const double probabilities[], int size) {
+    dist.values = nullptr;
+    dist.probabilities = nullptr;
+    dist.cdf = nullptr;
+    dist.mean = 0;
+    dist.variance = 0;
+    dist.alias.threshold = nullptr;
+    dist.alias.alias = nullptr;
+    dist.alias.values = nullptr;
+    dist.alias.size = 0;
+    dist.size = 0;
+    if (size <= 0) return false;
+    double total = 0;
+    for (int i = 0; i < size; i++) {
+        if (!(probabilities[i] >= 0)) return false;
+        total += probabilities[i];
+    }
+    if (!(total > 0) || std::isinf(total)) return false;
+
+    // Sort indices by value so duplicates become adjacent. Values whose merged
+    // probability is 0 are left out, so the support ends at values that can occur
+    int* order = new int[size];
+    for (int i = 0; i < size; i++) order[i] = i;
+    std::sort(order, order + size, [values](int a, int b) { return values[a] < values[b]; });
+
+    dist.values = new int[size];
+    dist.probabilities = new double[size];
+    dist.cdf = new double[size];
+    int count = 0;
+    for (int i = 0; i < size; i++) {
+        int v = values[order[i]];
+        double p = probabilities[order[i]] / total;
+        if (count > 0 && dist.values[count - 1] == v) {
+            dist.probabilities[count - 1] += p;
+        } else {
+            if (count > 0 && dist.probabilities[count - 1] == 0) count--;  // Drop zero-mass value
+            dist.values[count] = v;
+            dist.probabilities[count] = p;
+            count++;
+        }
+    }
+    if (dist.probabilities[count - 1] == 0) count--;
+    delete[] order;
+    dist.size = count;
+
+    // Cumulative sums, moments (two-pass, no pow)
+    double cumulative = 0, mean = 0;
+    for (int i = 0; i < count; i++) {
+        cumulative += dist.probabilities[i];
+        dist.cdf[i] = std::min(cumulative, 1.0);
+        mean += dist.values[i] * dist.probabilities[i];
+    }
+    dist.cdf[count - 1] = 1.0;  // Absorb rounding so quantile(p) always finds a value
+    double var = 0;
+    for (int i = 0; i < count; i++) {
+        double d = dist.values[i] - mean;
+        var += dist.probabilities[i] * d * d;
+    }
+    dist.mean = mean;
+    dist.variance = var;
+
+    if (!buildAliasTable(dist.alias, dist.values, dist.probabilities, count)) {
+        freeDiscreteDistribution(dist);
+        return false;
+    }
+    return true;
+}
+
+void freeDiscreteDistribution(DiscreteDistribution& dist) {
+    freeAliasTable(dist.alias);
+    delete[] dist.values;
+    delete[] dist.probabilities;
+    delete[] dist.cdf;
+    dist.values = nullptr;
+    dist.probabilities = nullptr;
+    dist.cdf = nullptr;
+    dist.mean = 0;
+    dist.variance = 0;
+    dist.size = 0;
+}
+
+double discreteMean(const DiscreteDistribution& dist) {
+    return dist.mean;
+}
+
+double discreteVariance(const DiscreteDistribution& dist) {
+    return dist.variance;
+}
+
+double discreteStandardDeviation(const DiscreteDistribution& dist) {
+    return sqrt(dist.variance);
+}
+
+double discretePmf(const DiscreteDistribution& dist, int value) {
+    const int* end = dist.values + dist.size;
+    const int* it = std::lower_bound((const int*)dist.values, end, value);
+    if (it == end || *it != value) return 0.0;
+    return dist.probabilities[it - dist.values];
+}
+
+double discreteCdf(const DiscreteDistribution& dist, double x) {
+    if (dist.size == 0 || std::isnan(x)) return 0.0;
+    // Number of support values <= x
+    int lo = 0, hi = dist.size;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (dist.values[mid] <= x) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo == 0 ? 0.0 : dist.cdf[lo - 1];
+}
+
+int discreteQuantile(const DiscreteDistribution& dist, double p) {
+    if (dist.size == 0) return 0;
+    if (!(p > 0)) return dist.values[0];
+    if (p >= 1) return dist.values[dist.size - 1];
+    int index = (int)(std::lower_bound(dist.cdf, dist.cdf + dist.size, p) - dist.cdf);
+    return dist.values[index];
+}
+
+int sampleDiscrete(RandomGenerator& rng, const DiscreteDistribution& dist) {
+    return sampleAlias(rng, dist.alias);
+}
+
+void fillDiscreteDistribution(RandomGenerator& rng, const DiscreteDistribution& dist, int out[], int count) {
+    fillDiscrete(rng, dist.alias, out, count);
+}
@@ -0,0 +1,51 @@
+#ifndef DISCRETE_H
+#define DISCRETE_H
+
+#include "sampler.h"
+
+// Finite discrete distribution, validated and normalized once so that
+// moments, CDF lookups and sampling need no per-call recomputation
+// (unlike expectedValue()/variance() on raw arrays).
+struct DiscreteDistribution {
+    int* values;            // Support, ascending with duplicates merged and zero-mass values dropped
+    double* probabilities;  // Normalized P(X = values[i])
+    double* cdf;            // P(X <= values[i]); the last entry is exactly 1
+    double mean;
+    double variance;
+    AliasTable alias;       // O(1) sampling
+    int size;
+};
+
+// Builds the distribution from the same values[]/probabilities[] arrays used
+// by expectedValue(). Values may be in any order and repeat (their
+// probabilities are added). Returns false if size <= 0, any probability is
+// negative or NaN, or they sum to 0
+bool initDiscreteDistribution(DiscreteDistribution& dist, const int values[],
+                              const double probabilities[], int size);
+
+// Releases the distribution
+void freeDiscreteDistribution(DiscreteDistribution& dist);
+
+// Cached moments
+double discreteMean(const DiscreteDistribution& dist);
+double discreteVariance(const DiscreteDistribution& dist);
+double discreteStandardDeviation(const DiscreteDistribution& dist);
+
+// P(X = value), O(log size)
+double discretePmf(const DiscreteDistribution& dist, int value);
+
+// P(X <= x), O(log size)
+double discreteCdf(const DiscreteDistribution& dist, double x);
+
+// Smallest support value v with P(X <= v) >= p, O(log size).
+// p outside [0, 1] is clamped: p <= 0 gives the smallest and p >= 1 the
+// largest value with nonzero probability
+int discreteQuantile(const DiscreteDistribution& dist, double p);
+
+// One draw in O(1)
+int sampleDiscrete(RandomGenerator& rng, const DiscreteDistribution& dist);
+
+// out[i] = sampleDiscrete(rng, dist)
+void fillDiscreteDistribution(RandomGenerator& rng, const DiscreteDistribution& dist, int out[], int count);
+
+#endif
@@ -0,0 +1,451 @@
+#include "distributions.h"
+#include "../cstats/cstats.h"
+#include <cmath>
+#include <climits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+static const double PI = 3.14159265358979323846;
+static const double SQRT2 = 1.41421356237309504880;
+static const double SQRT_2PI = 2.50662827463100050242;
+
+// ==================== SPECIAL FUNCTIONS ====================
+// The Lentz fractions and the gamma series are shared with cstats; only the
+// lgamma normalizers are applied here, so batch functions can compute them once.
+
+// I_x(a, b) with a caller-supplied log normalizer lgamma(a+b) - lgamma(a) - lgamma(b)
+static double betaRatio(double a, double b, double x, double logNorm) {
+    if (x <= 0.0) return 0.0;
+    if (x >= 1.0) return 1.0;
+    double logFront = logNorm + a * log(x) + b * log1p(-x);
+    if (x < (a + 1.0) / (a + b + 2.0))
+        return exp(logFront) * incompleteBetaFraction(a, b, x) / a;
+    return 1.0 - exp(logFront) * incompleteBetaFraction(b, a, 1.0 - x) / b;
+}
+
+static double logBetaNorm(double a, double b) {
+    return lgamma(a + b) - lgamma(a) - lgamma(b);
+}
+
+// x^a e^-x / Gamma(a), the prefactor of the series and the continued fraction
+static double gammaPrefactor(double a, double x, double logGammaA) {
+    return exp(-x + a * log(x) - logGammaA);
+}
+
+static double gammaSeries(double a, double x, double logGammaA) {
+    return gammaPrefactor(a, x, logGammaA) * lowerIncompleteGammaSeries(a, x);
+}
+
+static double gammaContinuedFraction(double a, double x, double logGammaA) {
+    return gammaPrefactor(a, x, logGammaA) * upperIncompleteGammaFraction(a, x);
+}
+
+static double gammaLower(double a, double x, double logGammaA) {
+    if (x <= 0.0) return 0.0;
+    if (x < a + 1.0) return gammaSeries(a, x, logGammaA);
+    return 1.0 - gammaContinuedFraction(a, x, logGammaA);
+}
+
+static double gammaUpper(double a, double x, double logGammaA) {
+    if (x <= 0.0) return 1.0;
+    if (x < a + 1.0) return 1.0 - gammaSeries(a, x, logGammaA);
+    return gammaContinuedFraction(a, x, logGammaA);
+}
+
+// Inverts a continuous CDF with Newton steps, falling back to bisection
+// whenever a step leaves the bracket [lo, hi]. hi may be HUGE_VAL.
+typedef double (*DistributionFunction)(double x, double a, double b);
+
+static double invertCdf(double p, double x, double lo, double hi,
+                        DistributionFunction cdf, DistributionFunction pdf,
+                        double a, double b) {
+    if (hi == HUGE_VAL) {  // Grow an upper bracket
+        hi = x > 1.0 ? 2.0 * x : 2.0;
+        while (cdf(hi, a, b) < p && hi < 1e300) {
+            lo = hi;
+            hi *= 2.0;
+        }
+    }
+    if (!(x > lo && x < hi)) x = 0.5 * (lo + hi);
+    for (int iter = 0; iter < 200; iter++) {
+        double f = cdf(x, a, b) - p;
+        if (f == 0.0) return x;
+        if (f < 0.0) lo = x;
+        else hi = x;
+        double density = pdf(x, a, b);
+        double next = density > 0.0 ? x - f / density : lo;
+        if (!(next > lo && next < hi)) next = 0.5 * (lo + hi);
+        if (fabs(next - x) <= 1e-14 * fabs(next) || hi - lo <= 1e-15 * fabs(hi)) return next;
+        x = next;
+    }
+    return x;
+}
+
+// ==================== NORMAL ====================
+
+double normalPdf(double x, double mean, double stdev) {
+    if (stdev <= 0) return 0;
+    double z = (x - mean) / stdev;
+    return exp(-0.5 * z * z) / (stdev * SQRT_2PI);
+}
+
+double normalCdf(double x, double mean, double stdev) {
+    if (stdev <= 0) return 0;
+    return 0.5 * erfc(-(x - mean) / (stdev * SQRT2));
+}
+
+// Acklam's rational approximation of the standard normal quantile (|rel err| < 1.15e-9)
+static double acklamQuantile(double p) {
+    static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02,
+                               -2.759285104469687e+02, 1.383577518672690e+02,
+                               -3.066479806614716e+01, 2.506628277459239e+00};
+    static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02,
+                               -1.556989798598866e+02, 6.680131188771972e+01,
+                               -1.328068155288572e+01};
+    static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01,
+                               -2.400758277161838e+00, -2.549732539343734e+00,
+                               4.374664141464968e+00, 2.938163982698783e+00};
+    static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01,
+                               2.445134137142996e+00, 3.754408661907416e+00};
+    const double pLow = 0.02425;
+
+    if (p < pLow) {  // Lower tail
+        double q = sqrt(-2.0 * log(p));
+        return (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+               ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    }
+    if (p > 1.0 - pLow) {  // Upper tail
+        double q = sqrt(-2.0 * log1p(-p));
+        return -(((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+               ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    }
+    double q = p - 0.5;  // Central region
+    double r = q * q;
+    return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+           (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+}
+
+double normalQuantile(double p, double mean, double stdev) {
+    if (stdev <= 0 || p < 0 || p > 1) return 0;
+    if (p == 0) return -HUGE_VAL;
+    if (p == 1) return HUGE_VAL;
+    double x = acklamQuantile(p);
+    double e = 0.5 * erfc(-x / SQRT2) - p;  // One Halley step to full precision
+    double u = e * SQRT_2PI * exp(0.5 * x * x);
+    x = x - u / (1.0 + 0.5 * x * u);
+    return mean + stdev * x;
+}
+
+// ==================== STUDENT T ====================
+
+double studentTPdf(double t, double df) {
+    if (df <= 0) return 0;
+    double logDensity = lgamma(0.5 * (df + 1.0)) - lgamma(0.5 * df) - 0.5 * log(df * PI) -
+                        0.5 * (df + 1.0) * log1p(t * t / df);
+    return exp(logDensity);
+}
+
+// Two-sided tail I_{df/(df+t^2)}(df/2, 1/2) split by the sign of t
+static double studentTCdfWithNorm(double t, double df, double logNorm) {
+    double tail = 0.5 * betaRatio(0.5 * df, 0.5, df / (df + t * t), logNorm);
+    return t > 0 ? 1.0 - tail : tail;
+}
+
+double studentTCdf(double t, double df) {
+    if (df <= 0) return 0;
+    return studentTCdfWithNorm(t, df, logBetaNorm(0.5 * df, 0.5));
+}
+
+double studentTQuantile(double p, double df) {
+    if (df <= 0 || p < 0 || p > 1) return 0;
+    if (p == 0) return -HUGE_VAL;
+    if (p == 1) return HUGE_VAL;
+    if (p == 0.5) return 0;
+    // For the lower half, x = I^-1_{2p}(df/2, 1/2) and t = -sqrt(df (1 - x) / x)
+    double tail = p < 0.5 ? 2.0 * p : 2.0 * (1.0 - p);
+    double x = betaQuantile(tail, 0.5 * df, 0.5);
+    double t = sqrt(df * (1.0 - x) / x);
+    return p < 0.5 ? -t : t;
+}
+
+// ==================== CHI-SQUARE ====================
+
+double chiSquarePdf(double x, double k) {
+    if (k <= 0) return 0;
+    return gammaPdf(x, 0.5 * k, 2.0);
+}
+
+double chiSquareCdf(double x, double k) {
+    if (k <= 0) return 0;
+    return gammaLower(0.5 * k, 0.5 * x, lgamma(0.5 * k));
+}
+
+double chiSquareQuantile(double p, double k) {
+    if (k <= 0) return 0;
+    return gammaQuantile(p, 0.5 * k, 2.0);
+}
+
+// ==================== GAMMA ====================
+
+double gammaPdf(double x, double shape, double scale) {
+    if (shape <= 0 || scale <= 0 || x < 0) return 0;
+    if (x == 0) {
+        if (shape < 1) return HUGE_VAL;
+        return shape == 1 ? 1.0 / scale : 0.0;
+    }
+    double z = x / scale;
+    return exp((shape - 1.0) * log(z) - z - lgamma(shape)) / scale;
+}
+
+double gammaCdf(double x, double shape, double scale) {
+    if (shape <= 0 || scale <= 0) return 0;
+    return gammaLower(shape, x / scale, lgamma(shape));
+}
+
+double gammaQuantile(double p, double shape, double scale) {
+    if (shape <= 0 || scale <= 0 || p < 0 || p > 1) return 0;
+    if (p == 0) return 0;
+    if (p == 1) return HUGE_VAL;
+    // Wilson-Hilferty start (chi-square with 2*shape df, halved), or the
+    // small-x series P(a, x) ~ x^a / Gamma(a + 1) when that goes negative
+    double nu = 2.0 * shape;
+    double z = normalQuantile(p, 0, 1);
+    double w = 1.0 - 2.0 / (9.0 * nu) + z * sqrt(2.0 / (9.0 * nu));
+    double x = 0.5 * nu * w * w * w;
+    if (w <= 0 || x <= 0) x = exp((log(p) + lgamma(shape + 1.0)) / shape);
+    return scale * invertCdf(p, x, 0.0, HUGE_VAL, gammaCdf, gammaPdf, shape, 1.0);
+}
+
+// ==================== BETA ====================
+
+double betaPdf(double x, double a, double b) {
+    if (a <= 0 || b <= 0 || x < 0 || x > 1) return 0;
+    if (x == 0) {
+        if (a < 1) return HUGE_VAL;
+        return a == 1 ? b : 0.0;
+    }
+    if (x == 1) {
+        if (b < 1) return HUGE_VAL;
+        return b == 1 ? a : 0.0;
+    }
+    return exp(logBetaNorm(a, b) + (a - 1.0) * log(x) + (b - 1.0) * log1p(-x));
+}
+
+double betaCdf(double x, double a, double b) {
+    if (a <= 0 || b <= 0) return 0;
+    return betaRatio(a, b, x, logBetaNorm(a, b));
+}
+
+double betaQuantile(double p, double a, double b) {
+    if (a <= 0 || b <= 0 || p < 0 || p > 1) return 0;
+    if (p == 0) return 0;
+    if (p == 1) return 1;
+    double x = a / (a + b);  // Start at the mean
+    return invertCdf(p, x, 0.0, 1.0, betaCdf, betaPdf, a, b);
+}
+
+// ==================== POISSON ====================
+
+double poissonPmf(int k, double lambda) {
+    if (k < 0 || lambda < 0) return 0;
+    if (lambda == 0) return k == 0 ? 1.0 : 0.0;
+    return exp(k * log(lambda) - lambda - lgamma(k + 1.0));
+}
+
+double poissonCdf(int k, double lambda) {
+    if (k < 0 || lambda < 0) return 0;
+    if (lambda == 0) return 1;
+    return gammaUpper(k + 1.0, lambda, lgamma(k + 1.0));
+}
+
+// Starts from the normal approximation, then steps to the exact answer
+int poissonQuantile(double p, double lambda) {
+    if (lambda < 0 || p < 0 || p > 1) return 0;
+    if (lambda == 0 || p == 0) return 0;
+    if (p == 1) return INT_MAX;
+    double guess = floor(lambda + normalQuantile(p, 0, 1) * sqrt(lambda));
+    int k = guess > 0 ? (int)guess : 0;
+    while (poissonCdf(k, lambda) < p) k++;
+    while (k > 0 && poissonCdf(k - 1, lambda) >= p) k--;
+    return k;
+}
+
+// ==================== BATCH EVALUATION ====================
+
+// Abramowitz-Stegun 26.2.17 coefficients: 1 - Phi(z) ~ phi(z) * poly(1 / (1 + P z)), z >= 0
+static const double AS_P = 0.2316419;
+static const double AS_B1 = 0.319381530;
+static const double AS_B2 = -0.356563782;
+static const double AS_B3 = 1.781477937;
+static const double AS_B4 = -1.821255978;
+static const double AS_B5 = 1.330274429;
+
+#if defined(__SSE2__)
+
+// exp(x) for two doubles: x = k ln2 + r with |r| <= ln2/2, degree-13 Taylor
+// polynomial for e^r, 2^k assembled in the exponent bits. Relative error < 1e-15.
+static inline __m128d expPd(__m128d x) {
+    const __m128d ln2Hi = _mm_set1_pd(6.93147180369123816490e-01);
+    const __m128d ln2Lo = _mm_set1_pd(1.90821492927058770002e-10);
+    x = _mm_max_pd(x, _mm_set1_pd(-708.0));
+    x = _mm_min_pd(x, _mm_set1_pd(709.0));
+    __m128i k = _mm_cvtpd_epi32(_mm_mul_pd(x, _mm_set1_pd(1.44269504088896340736)));
+    __m128d kd = _mm_cvtepi32_pd(k);
+    __m128d r = _mm_sub_pd(_mm_sub_pd(x, _mm_mul_pd(kd, ln2Hi)), _mm_mul_pd(kd, ln2Lo));
+
+    __m128d poly = _mm_set1_pd(1.0 / 6227020800.0);  // 1/13!
+    static const double coeffs[] = {1.0 / 479001600.0, 1.0 / 39916800.0, 1.0 / 3628800.0,
+                                    1.0 / 362880.0, 1.0 / 40320.0, 1.0 / 5040.0, 1.0 / 720.0,
+                                    1.0 / 120.0, 1.0 / 24.0, 1.0 / 6.0, 0.5, 1.0, 1.0};
+    for (int i = 0; i < 13; i++) {
+        poly = _mm_add_pd(_mm_mul_pd(poly, r), _mm_set1_pd(coeffs[i]));
+    }
+
+    // Biased exponent (k + 1023) moved from two int32 lanes into two int64 lanes
+    __m128i biased = _mm_add_epi32(k, _mm_set1_epi32(1023));
+    __m128i wide = _mm_unpacklo_epi32(biased, _mm_setzero_si128());
+    __m128d scale = _mm_castsi128_pd(_mm_slli_epi64(wide, 52));
+    return _mm_mul_pd(poly, scale);
+}
+
+// Standard normal density for two z values
+static inline __m128d normalPdfPd(__m128d z) {
+    __m128d arg = _mm_mul_pd(_mm_set1_pd(-0.5), _mm_mul_pd(z, z));
+    return _mm_mul_pd(expPd(arg), _mm_set1_pd(1.0 / SQRT_2PI));
+}
+
+// Standard normal CDF for two z values, branch-free reflection for z < 0
+static inline __m128d normalCdfPd(__m128d z) {
+    const __m128d one = _mm_set1_pd(1.0);
+    __m128d negative = _mm_cmplt_pd(z, _mm_setzero_pd());
+    __m128d absZ = _mm_andnot_pd(_mm_set1_pd(-0.0), z);
+    __m128d t = _mm_div_pd(one, _mm_add_pd(one, _mm_mul_pd(_mm_set1_pd(AS_P), absZ)));
+    __m128d poly = _mm_set1_pd(AS_B5);
+    poly = _mm_add_pd(_mm_mul_pd(poly, t), _mm_set1_pd(AS_B4));
+    poly = _mm_add_pd(_mm_mul_pd(poly, t), _mm_set1_pd(AS_B3));
+    poly = _mm_add_pd(_mm_mul_pd(poly, t), _mm_set1_pd(AS_B2));
+    poly = _mm_add_pd(_mm_mul_pd(poly, t), _mm_set1_pd(AS_B1));
+    poly = _mm_mul_pd(poly, t);
+    __m128d upper = _mm_mul_pd(normalPdfPd(absZ), poly);  // 1 - Phi(|z|)
+    __m128d lower = _mm_sub_pd(one, upper);
+    return _mm_or_pd(_mm_and_pd(negative, upper), _mm_andnot_pd(negative, lower));
+}
+
+// Applies a two-lane kernel to (x - mean) / stdev; the odd tail uses a broadcast
+template <typename Kernel>
+static void normalBatch(const double x[], double result[], int n, double mean, double stdev,
+                        double outScale, Kernel kernel) {
+    const __m128d m = _mm_set1_pd(mean);
+    const __m128d inv = _mm_set1_pd(1.0 / stdev);
+    const __m128d out = _mm_set1_pd(outScale);
+    int i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d z = _mm_mul_pd(_mm_sub_pd(_mm_loadu_pd(x + i), m), inv);
+        _mm_storeu_pd(result + i, _mm_mul_pd(kernel(z), out));
+    }
+    if (i < n) {
+        __m128d z = _mm_mul_pd(_mm_sub_pd(_mm_set1_pd(x[i]), m), inv);
+        _mm_store_sd(result + i, _mm_mul_pd(kernel(z), out));
+    }
+}
+
+void normalPdfBatch(const double x[], double result[], int n, double mean, double stdev) {
+    if (stdev <= 0) {
+        for (int i = 0; i < n; i++) result[i] = 0;
+        return;
+    }
+    normalBatch(x, result, n, mean, stdev, 1.0 / stdev, normalPdfPd);
+}
+
+void normalCdfBatch(const double x[], double result[], int n, double mean, double stdev) {
+    if (stdev <= 0) {
+        for (int i = 0; i < n; i++) result[i] = 0;
+        return;
+    }
+    normalBatch(x, result, n, mean, stdev, 1.0, normalCdfPd);
+}
+
+#else
+
+// Portable fallback with the same polynomial as the SSE2 kernel
+static double normalCdfPoly(double z) {
+    double absZ = fabs(z);
+    double t = 1.0 / (1.0 + AS_P * absZ);
+    double poly = ((((AS_B5 * t + AS_B4) * t + AS_B3) * t + AS_B2) * t + AS_B1) * t;
+    double upper = exp(-0.5 * absZ * absZ) / SQRT_2PI * poly;
+    return z < 0 ? upper : 1.0 - upper;
+}
+
+void normalPdfBatch(const double x[], double result[], int n, double mean, double stdev) {
+    for (int i = 0; i < n; i++) result[i] = normalPdf(x[i], mean, stdev);
+}
+
+void normalCdfBatch(const double x[], double result[], int n, double mean, double stdev) {
+    if (stdev <= 0) {
+        for (int i = 0; i < n; i++) result[i] = 0;
+        return;
+    }
+    double inv = 1.0 / stdev;
+    for (int i = 0; i < n; i++) result[i] = normalCdfPoly((x[i] - mean) * inv);
+}
+
+#endif
+
+void normalQuantileBatch(const double p[], double result[], int n, double mean, double stdev) {
+    for (int i = 0; i < n; i++) {
+        if (stdev <= 0 || p[i] < 0 || p[i] > 1) result[i] = 0;
+        else if (p[i] == 0) result[i] = -HUGE_VAL;
+        else if (p[i] == 1) result[i] = HUGE_VAL;
+        else result[i] = mean + stdev * acklamQuantile(p[i]);
+    }
+}
+
+void studentTCdfBatch(const double t[], double result[], int n, double df) {
+    if (df <= 0) {
+        for (int i = 0; i < n; i++) result[i] = 0;
+        return;
+    }
+    double logNorm = logBetaNorm(0.5 * df, 0.5);
+    for (int i = 0; i < n; i++) result[i] = studentTCdfWithNorm(t[i], df, logNorm);
+}
+
+void chiSquareCdfBatch(const double x[], double result[], int n, double k) {
+    if (k <= 0) {
+        for (int i = 0; i < n; i++) result[i] = 0;
+        return;
+    }
+    double logGammaA = lgamma(0.5 * k);
+    for (int i = 0; i < n; i++) result[i] = gammaLower(0.5 * k, 0.5 * x[i], logGammaA);
+}
+
+void gammaCdfBatch(const double x[], double result[], int n, double shape, double scale) {
+    if (shape <= 0 || scale <= 0) {
+        for (int i = 0; i < n; i++) result[i] = 0;
+        return;
+    }
+    double logGammaA = lgamma(shape);
+    double inv = 1.0 / scale;
+    for (int i = 0; i < n; i++) result[i] = gammaLower(shape, x[i] * inv, logGammaA);
+}
+
+void betaCdfBatch(const double x[], double result[], int n, double a, double b) {
+    if (a <= 0 || b <= 0) {
+        for (int i = 0; i < n; i++) result[i] = 0;
+        return;
+    }
+    double logNorm = logBetaNorm(a, b);
+    for (int i = 0; i < n; i++) result[i] = betaRatio(a, b, x[i], logNorm);
+}
+
+void poissonPmfBatch(const int k[], double result[], int n, double lambda) {
+    if (lambda <= 0) {
+        for (int i = 0; i < n; i++) result[i] = poissonPmf(k[i], lambda);
+        return;
+    }
+    double logLambda = log(lambda);
+    for (int i = 0; i < n; i++) {
+        result[i] = k[i] < 0 ? 0.0 : exp(k[i] * logLambda - lambda - lgamma(k[i] + 1.0));
+    }
+}
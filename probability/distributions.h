@@ -0,0 +1,103 @@
+#ifndef DISTRIBUTIONS_H
+#define DISTRIBUTIONS_H
+
+// Continuous and discrete distribution functions (PDF/PMF, CDF, quantile).
+// Invalid parameters return 0.0. Quantiles return -HUGE_VAL / HUGE_VAL at
+// p = 0 / p = 1 where the support is unbounded.
+// The incomplete beta/gamma kernels come from cstats: link ../cstats/cstats.cpp.
+
+// ==================== NORMAL ====================
+
+// Normal density with the given mean and standard deviation
+double normalPdf(double x, double mean, double stdev);
+
+// Normal CDF via erfc (full double precision)
+double normalCdf(double x, double mean, double stdev);
+
+// Normal quantile: Acklam's rational approximation refined by one Halley step
+double normalQuantile(double p, double mean, double stdev);
+
+// ==================== STUDENT T ====================
+
+// Student-t density with df degrees of freedom
+double studentTPdf(double t, double df);
+
+// Student-t CDF via the regularized incomplete beta function
+double studentTCdf(double t, double df);
+
+// Student-t quantile
+double studentTQuantile(double p, double df);
+
+// ==================== CHI-SQUARE ====================
+
+// Chi-square density with k degrees of freedom
+double chiSquarePdf(double x, double k);
+
+// Chi-square CDF: P(k/2, x/2)
+double chiSquareCdf(double x, double k);
+
+// Chi-square quantile
+double chiSquareQuantile(double p, double k);
+
+// ==================== GAMMA ====================
+
+// Gamma density with shape and scale parameters
+double gammaPdf(double x, double shape, double scale);
+
+// Gamma CDF: regularized lower incomplete gamma P(shape, x/scale)
+double gammaCdf(double x, double shape, double scale);
+
+// Gamma quantile (Wilson-Hilferty start, safeguarded Newton)
+double gammaQuantile(double p, double shape, double scale);
+
+// ==================== BETA ====================
+
+// Beta density on [0, 1]
+double betaPdf(double x, double a, double b);
+
+// Beta CDF: regularized incomplete beta I_x(a, b)
+double betaCdf(double x, double a, double b);
+
+// Beta quantile (safeguarded Newton on [0, 1])
+double betaQuantile(double p, double a, double b);
+
+// ==================== POISSON ====================
+
+// Poisson probability mass P(X = k), evaluated in log space
+double poissonPmf(int k, double lambda);
+
+// Poisson CDF P(X <= k) = Q(k + 1, lambda)
+double poissonCdf(int k, double lambda);
+
+// Smallest k with P(X <= k) >= p
+int poissonQuantile(double p, double lambda);
+
+// ==================== BATCH EVALUATION ====================
+// Each batch function writes result[i] for x[i], i = 0 .. n-1.
+// Normal kernels use SSE2 (two doubles per instruction) when available.
+
+// Normal density; vector exp with relative error below 1e-15
+void normalPdfBatch(const double x[], double result[], int n, double mean, double stdev);
+
+// Normal CDF; Abramowitz-Stegun 26.2.17 polynomial, absolute error below 7.5e-8
+void normalCdfBatch(const double x[], double result[], int n, double mean, double stdev);
+
+// Normal quantile; Acklam's approximation without refinement, relative error below 1.2e-9
+void normalQuantileBatch(const double p[], double result[], int n, double mean, double stdev);
+
+// Student-t CDF; the log-beta normalizer is computed once per batch
+void studentTCdfBatch(const double t[], double result[], int n, double df);
+
+// Chi-square CDF; the log-gamma normalizer is computed once per batch
+void chiSquareCdfBatch(const double x[], double result[], int n, double k);
+
+// Gamma CDF; the log-gamma normalizer is computed once per batch
+void gammaCdfBatch(const double x[], double result[], int n, double shape, double scale);
+
+// Beta CDF; the log-beta normalizer is computed once per batch
+void betaCdfBatch(const double x[], double result[], int n, double a, double b);
+
+// Poisson PMF; log(lambda) is computed once per batch
+void poissonPmfBatch(const int k[], double result[], int n, double lambda);
+
+#endif
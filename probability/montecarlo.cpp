@@ -0,0 +1,136 @@
+#include "montecarlo.h"
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <thread>
+#include <vector>
+
+// Batches scheduled between early-stopping checks. Fixed (not derived from the
+// thread count) so that stopping decisions are reproducible
+static const int BATCHES_PER_ROUND = 64;
+
+// ==================== ACCUMULATOR ====================
+
+void resetAccumulator(MonteCarloAccumulator& acc) {
+    acc.count = 0;
+    acc.nonzero = 0;
+    acc.mean = 0;
+    acc.m2 = 0;
+    acc.min = HUGE_VAL;
+    acc.max = -HUGE_VAL;
+}
+
+void accumulate(MonteCarloAccumulator& acc, double value) {
+    acc.count++;
+    if (value != 0) acc.nonzero++;
+    double delta = value - acc.mean;
+    acc.mean += delta / acc.count;
+    acc.m2 += delta * (value - acc.mean);
+    if (value < acc.min) acc.min = value;
+    if (value > acc.max) acc.max = value;
+}
+
+// Pairwise combination: M2 = M2a + M2b + delta^2 * na * nb / n
+void mergeAccumulators(MonteCarloAccumulator& acc, const MonteCarloAccumulator& other) {
+    if (other.count == 0) return;
+    if (acc.count == 0) {
+        acc = other;
+        return;
+    }
+    double na = (double)acc.count, nb = (double)other.count;
+    double n = na + nb;
+    double delta = other.mean - acc.mean;
+    acc.mean += delta * nb / n;
+    acc.m2 += other.m2 + delta * delta * na * nb / n;
+    acc.count += other.count;
+    acc.nonzero += other.nonzero;
+    if (other.min < acc.min) acc.min = other.min;
+    if (other.max > acc.max) acc.max = other.max;
+}
+
+double accumulatorVariance(const MonteCarloAccumulator& acc) {
+    if (acc.count < 2) return 0.0;
+    return acc.m2 / (acc.count - 1);
+}
+
+double accumulatorStandardError(const MonteCarloAccumulator& acc) {
+    if (acc.count < 2) return HUGE_VAL;
+    return sqrt(accumulatorVariance(acc) / acc.count);
+}
+
+// ==================== DRIVER ====================
+
+void defaultMonteCarloOptions(MonteCarloOptions& options) {
+    options.maxTrials = 10000000;
+    options.minTrials = 1000;
+    options.minEvents = 100;
+    options.targetStandardError = 0;
+    options.batchSize = 4096;
+    options.threads = 0;
+    options.seed = 1;
+}
+
+struct BatchJob {
+    RandomGenerator rng;
+    long long trials;
+    MonteCarloAccumulator stats;
+};
+
+static void runBatches(TrialKernel kernel, void* context, std::vector<BatchJob>& jobs,
+                       int jobCount, std::atomic<int>& nextJob) {
+    for (;;) {
+        int j = nextJob.fetch_add(1);
+        if (j >= jobCount) return;
+        BatchJob& job = jobs[j];
+        resetAccumulator(job.stats);
+        for (long long t = 0; t < job.trials; t++) accumulate(job.stats, kernel(job.rng, context));
+    }
+}
+
+bool runMonteCarlo(TrialKernel kernel, void* context, const MonteCarloOptions& options,
+                   MonteCarloAccumulator& result) {
+    resetAccumulator(result);
+    if (!kernel || options.maxTrials <= 0 || options.batchSize <= 0 || options.threads < 0 ||
+        options.targetStandardError < 0 || options.minEvents < 0) {
+        return false;
+    }
+    int threads = options.threads;
+    if (threads == 0) threads = (int)std::thread::hardware_concurrency();
+    if (threads <= 0) threads = 1;
+    if (threads > BATCHES_PER_ROUND) threads = BATCHES_PER_ROUND;
+
+    RandomGenerator stream;
+    seedRandom(stream, options.seed);
+    std::vector<BatchJob> jobs(BATCHES_PER_ROUND);
+    long long scheduled = 0;
+
+    while (scheduled < options.maxTrials) {
+        // Hand out the next round's streams in batch order
+        int jobCount = 0;
+        while (jobCount < BATCHES_PER_ROUND && scheduled < options.maxTrials) {
+            long long remaining = options.maxTrials - scheduled;
+            jobs[jobCount].rng = stream;
+            jobs[jobCount].trials = remaining < options.batchSize ? remaining : options.batchSize;
+            jumpRandom(stream);
+            scheduled += jobs[jobCount].trials;
+            jobCount++;
+        }
+
+        std::atomic<int> nextJob(0);
+        int workers = threads < jobCount ? threads : jobCount;
+        std::vector<std::thread> pool;
+        for (int w = 1; w < workers; w++) {
+            pool.emplace_back(runBatches, kernel, context, std::ref(jobs), jobCount, std::ref(nextJob));
+        }
+        runBatches(kernel, context, jobs, jobCount, nextJob);
+        for (size_t w = 0; w < pool.size(); w++) pool[w].join();
+
+        for (int j = 0; j < jobCount; j++) mergeAccumulators(result, jobs[j].stats);
+        if (options.targetStandardError > 0 && result.count >= options.minTrials &&
+            result.nonzero >= options.minEvents &&
+            accumulatorStandardError(result) <= options.targetStandardError) {
+            return true;
+        }
+    }
+    return false;
+}
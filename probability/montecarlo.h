@@ -0,0 +1,69 @@
+#ifndef MONTECARLO_H
+#define MONTECARLO_H
+
+#include "sampler.h"
+#include <cstdint>
+
+// Parallel Monte Carlo driver. Trials are grouped into fixed-size batches;
+// batch b always draws from the seed's stream jumped b times and batch
+// results are merged in batch order, so a given seed gives the same answer
+// whatever the thread count.
+
+// ==================== ACCUMULATOR ====================
+
+// Mergeable running statistics (Welford update, Chan et al. merge)
+struct MonteCarloAccumulator {
+    long long count;
+    long long nonzero;  // Observations != 0 (events, for indicator kernels)
+    double mean;
+    double m2;  // Sum of squared deviations from the mean
+    double min;
+    double max;
+};
+
+// Empties the accumulator
+void resetAccumulator(MonteCarloAccumulator& acc);
+
+// Adds one observation
+void accumulate(MonteCarloAccumulator& acc, double value);
+
+// Folds other into acc, as if all of other's observations were added to acc
+void mergeAccumulators(MonteCarloAccumulator& acc, const MonteCarloAccumulator& other);
+
+// Sample variance (n - 1 denominator), 0.0 if count < 2
+double accumulatorVariance(const MonteCarloAccumulator& acc);
+
+// Standard error of the mean, sqrt(variance / count); HUGE_VAL if count < 2
+double accumulatorStandardError(const MonteCarloAccumulator& acc);
+
+// ==================== DRIVER ====================
+
+// One trial: draw from rng only and return the observation (e.g. 1.0/0.0 for
+// a tail event; make the rare outcome the nonzero one so it counts toward
+// minEvents). Called concurrently, so any shared context must be read-only
+typedef double (*TrialKernel)(RandomGenerator& rng, void* context);
+
+struct MonteCarloOptions {
+    long long maxTrials;         // Hard limit on the number of trials
+    long long minTrials;         // Trials required before early stopping
+    long long minEvents;         // Nonzero observations required before early stopping
+    double targetStandardError;  // Stop once the standard error is at or below this (0 = never)
+    int batchSize;               // Trials per batch (one RNG stream each)
+    int threads;                 // Worker threads, 0 = hardware concurrency
+    uint64_t seed;
+};
+
+// maxTrials 10^7, minTrials 1000, minEvents 100, no early stopping,
+// batches of 4096, all cores, seed 1
+void defaultMonteCarloOptions(MonteCarloOptions& options);
+
+// Runs trials until maxTrials or the target standard error is reached.
+// Early stopping is checked after every round of 64 batches and also needs
+// minEvents nonzero observations: with few or no hits on a rare event the
+// sample variance (and so the standard error) is near 0 and meaningless.
+// Returns true if the target standard error was reached; false otherwise
+// (including invalid options, which leave result empty)
+bool runMonteCarlo(TrialKernel kernel, void* context, const MonteCarloOptions& options,
+                   MonteCarloAccumulator& result);
+
+#endif
@@ -1,22 +1,65 @@
 #include "probability.h"
 #include <cmath>
+#include <climits>
+#include <mutex>
+#include <vector>
 
-// Factorial function for probability calculations
+// ==================== COMPILE-TIME TABLES ====================
+
+// Largest n whose factorial fits in a signed 64-bit integer
+static const int MAX_FACTORIAL_N = 20;
+
+// Largest n whose every binomial coefficient nCr fits in a signed 64-bit integer
+static const int MAX_PASCAL_N = 66;
+
+struct FactorialTable {
+    long long values[MAX_FACTORIAL_N + 1];
+    constexpr FactorialTable() : values() {
+        values[0] = 1;
+        for (int i = 1; i <= MAX_FACTORIAL_N; i++) values[i] = values[i - 1] * i;
+    }
+};
+
+struct PascalTable {
+    long long rows[MAX_PASCAL_N + 1][MAX_PASCAL_N + 1];
+    constexpr PascalTable() : rows() {
+        for (int n = 0; n <= MAX_PASCAL_N; n++) {
+            rows[n][0] = 1;
+            for (int r = 1; r <= n; r++) {
+                rows[n][r] = rows[n - 1][r - 1] + (r < n ? rows[n - 1][r] : 0);
+            }
+        }
+    }
+};
+
+static constexpr FactorialTable factorialTable;
+static constexpr PascalTable pascalTable;
+
+static long long gcd(long long a, long long b) {
+    while (b != 0) {
+        long long t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+// ==================== COMBINATORICS ====================
+
+// Factorial function for probability calculations (table lookup)
 long long factorial(int n) {
     if (n < 0) return 0;
-    if (n <= 1) return 1;
-    long long result = 1;
-    for (int i = 2; i <= n; i++) {
-        result *= i;
-    }
-    return result;
+    if (n > MAX_FACTORIAL_N) return -1;  // Overflow
+    return factorialTable.values[n];
 }
 
 // Permutation: nPr = n! / (n-r)!
 long long permutation(int n, int r) {
     if (r > n || r < 0 || n < 0) return 0;
+    if (n <= MAX_FACTORIAL_N) return factorialTable.values[n] / factorialTable.values[n - r];
     long long result = 1;
     for (int i = n; i > n - r; i--) {
+        if (result > LLONG_MAX / i) return -1;  // Overflow
         result *= i;
     }
     return result;
@@ -25,19 +68,285 @@ long long permutation(int n, int r) {
 // Combination: nCr = n! / (r! * (n-r)!)
 long long combination(int n, int r) {
     if (r > n || r < 0 || n < 0) return 0;
+    if (n <= MAX_PASCAL_N) return pascalTable.rows[n][r];
     if (r > n - r) r = n - r; // Optimization
+    // result * (n-i) / (i+1) is always an integer; cancel the gcd first so the
+    // intermediate product only overflows when the final answer would
     long long result = 1;
     for (int i = 0; i < r; i++) {
-        result *= (n - i);
-        result /= (i + 1);
+        long long g = gcd(result, i + 1);
+        long long divisor = (i + 1) / g;
+        long long factor = (n - i) / divisor;
+        result /= g;
+        if (result > LLONG_MAX / factor) return -1;  // Overflow
+        result *= factor;
     }
     return result;
 }
 
-// Binomial probability: P(X=k) = nCr * p^k * (1-p)^(n-k)
+// ==================== LOG-FACTORIAL TABLE ====================
+
+// Fixed-size table of log(n!), filled exactly once on first use and read-only
+// afterwards, so concurrent callers never see it change. Beyond the table
+// lgamma is used directly
+static const int LOG_FACTORIAL_TABLE_SIZE = 1 << 12;
+static double logFactorialTable[LOG_FACTORIAL_TABLE_SIZE];
+static std::once_flag logFactorialTableOnce;
+
+static void fillLogFactorialTable() {
+    for (int i = 0; i < LOG_FACTORIAL_TABLE_SIZE; i++) logFactorialTable[i] = lgamma(i + 1.0);
+}
+
+double logFactorial(int n) {
+    if (n < 0) return -HUGE_VAL;
+    if (n >= LOG_FACTORIAL_TABLE_SIZE) return lgamma(n + 1.0);
+    std::call_once(logFactorialTableOnce, fillLogFactorialTable);
+    return logFactorialTable[n];
+}
+
+// Log of nCr from the log-factorial table: never overflows
+double logCombination(int n, int r) {
+    if (r > n || r < 0 || n < 0) return -HUGE_VAL;
+    return logFactorial(n) - logFactorial(r) - logFactorial(n - r);
+}
+
+// ==================== MODULAR COMBINATORICS ====================
+
+// base^exponent mod modulus by repeated squaring
+long long modPower(long long base, long long exponent, long long modulus) {
+    if (modulus <= 1 || exponent < 0) return 0;
+    long long result = 1;
+    base %= modulus;
+    if (base < 0) base += modulus;
+    while (exponent > 0) {
+        if (exponent & 1) result = result * base % modulus;
+        base = base * base % modulus;
+        exponent >>= 1;
+    }
+    return result;
+}
+
+// Fills n! mod p upwards, then inverse factorials downwards from one Fermat inverse
+bool initModularBinomial(ModularBinomial& table, int maxN, long long modulus) {
+    table.factorials = nullptr;
+    table.inverseFactorials = nullptr;
+    table.maxN = -1;
+    table.modulus = 0;
+    // modulus must exceed maxN (so no factorial is 0 mod p) and keep products in range
+    if (maxN < 0 || modulus <= maxN || modulus < 2 || modulus > 3037000499LL) return false;
+    table.factorials = new long long[maxN + 1];
+    table.inverseFactorials = new long long[maxN + 1];
+    table.maxN = maxN;
+    table.modulus = modulus;
+    table.factorials[0] = 1;
+    for (int i = 1; i <= maxN; i++) {
+        table.factorials[i] = table.factorials[i - 1] * i % modulus;
+    }
+    table.inverseFactorials[maxN] = modPower(table.factorials[maxN], modulus - 2, modulus);
+    for (int i = maxN; i > 0; i--) {
+        table.inverseFactorials[i - 1] = table.inverseFactorials[i] * i % modulus;
+    }
+    return true;
+}
+
+void freeModularBinomial(ModularBinomial& table) {
+    delete[] table.factorials;
+    delete[] table.inverseFactorials;
+    table.factorials = nullptr;
+    table.inverseFactorials = nullptr;
+    table.maxN = -1;
+    table.modulus = 0;
+}
+
+long long modFactorial(const ModularBinomial& table, int n) {
+    if (n < 0 || n > table.maxN) return 0;
+    return table.factorials[n];
+}
+
+long long modPermutation(const ModularBinomial& table, int n, int r) {
+    if (r > n || r < 0 || n < 0 || n > table.maxN) return 0;
+    return table.factorials[n] * table.inverseFactorials[n - r] % table.modulus;
+}
+
+long long modCombination(const ModularBinomial& table, int n, int r) {
+    if (r > n || r < 0 || n < 0 || n > table.maxN) return 0;
+    long long partial = table.factorials[n] * table.inverseFactorials[r] % table.modulus;
+    return partial * table.inverseFactorials[n - r] % table.modulus;
+}
+
+// ==================== BINOMIAL DISTRIBUTION ====================
+
+// log P(X=k) = log nCk + k log p + (n-k) log(1-p)
+double logBinomialProbability(int n, int k, double p) {
+    if (k > n || k < 0 || n < 0 || p < 0 || p > 1) return -HUGE_VAL;
+    if (p == 0) return k == 0 ? 0.0 : -HUGE_VAL;  // Avoid 0 * log(0)
+    if (p == 1) return k == n ? 0.0 : -HUGE_VAL;
+    return logCombination(n, k) + k * log(p) + (n - k) * log1p(-p);
+}
+
+// Binomial probability: P(X=k) = nCr * p^k * (1-p)^(n-k), evaluated in log space
 double binomialProbability(int n, int k, double p) {
     if (k > n || k < 0 || n < 0 || p < 0 || p > 1) return 0;
-    return combination(n, k) * pow(p, k) * pow(1 - p, n - k);
+    return exp(logBinomialProbability(n, k, p));
+}
+
+// Whole binomial distribution in O(n): start at the mode (computed in log space,
+// so it never underflows) and walk outwards with the ratio
+//   P(k+1) / P(k) = (n-k) / (k+1) * p / (1-p)
+void binomialDistribution(int n, double p, double pmf[], double cdf[]) {
+    if (n < 0) return;
+    if (p < 0 || p > 1) {
+        for (int k = 0; k <= n; k++) {
+            pmf[k] = 0;
+            if (cdf) cdf[k] = 0;
+        }
+        return;
+    }
+    if (p == 0 || p == 1) {
+        for (int k = 0; k <= n; k++) pmf[k] = 0;
+        pmf[p == 0 ? 0 : n] = 1;
+    } else {
+        int mode = (int)((n + 1) * p);
+        if (mode > n) mode = n;
+        double odds = p / (1 - p);
+        pmf[mode] = binomialProbability(n, mode, p);
+        for (int k = mode; k < n; k++) {
+            pmf[k + 1] = pmf[k] * (n - k) / (k + 1.0) * odds;
+        }
+        for (int k = mode; k > 0; k--) {
+            pmf[k - 1] = pmf[k] * k / ((n - k + 1.0) * odds);
+        }
+        // Renormalize: removes the lgamma rounding carried in from pmf[mode]
+        double total = 0;
+        for (int k = 0; k <= n; k++) total += pmf[k];
+        for (int k = 0; k <= n; k++) pmf[k] /= total;
+    }
+    if (cdf) {
+        double total = 0;
+        for (int k = 0; k <= n; k++) {
+            total += pmf[k];
+            cdf[k] = total < 1 ? total : 1;
+        }
+    }
+}
+
+// ==================== HYPERGEOMETRIC DISTRIBUTION ====================
+
+// log P(X=k) = log KCk + log (N-K)C(n-k) - log NCn
+double logHypergeometricProbability(int population, int successes, int draws, int k) {
+    if (population < 0 || successes < 0 || draws < 0 || successes > population || draws > population) {
+        return -HUGE_VAL;
+    }
+    if (k < 0 || k > successes || draws - k > population - successes || k > draws) return -HUGE_VAL;
+    return logCombination(successes, k) + logCombination(population - successes, draws - k) -
+           logCombination(population, draws);
+}
+
+double hypergeometricProbability(int population, int successes, int draws, int k) {
+    return exp(logHypergeometricProbability(population, successes, draws, k));
+}
+
+// log nCr straight from lgamma, for one-off terms that should not touch a table
+static double lgammaCombination(double n, double r) {
+    return lgamma(n + 1.0) - lgamma(r + 1.0) - lgamma(n - r + 1.0);
+}
+
+// Same mode-outward walk as binomialDistribution with the ratio
+//   P(k+1) / P(k) = (K-k)(n-k) / ((k+1)(N-K-n+k+1)).
+// Only the mode term is evaluated in log space (nine lgamma calls)
+void hypergeometricDistribution(int population, int successes, int draws, double pmf[], double cdf[]) {
+    if (population < 0 || successes < 0 || draws < 0 || successes > population || draws > population) {
+        return;
+    }
+    int last = draws < successes ? draws : successes;
+    int first = draws - (population - successes);
+    if (first < 0) first = 0;
+    for (int k = 0; k < first; k++) pmf[k] = 0;
+
+    int mode = (int)(((double)draws + 1) * ((double)successes + 1) / ((double)population + 2));
+    if (mode < first) mode = first;
+    if (mode > last) mode = last;
+    double failures = (double)population - successes;
+    pmf[mode] = exp(lgammaCombination(successes, mode) + lgammaCombination(failures, (double)draws - mode) -
+                    lgammaCombination(population, draws));
+    for (int k = mode; k < last; k++) {
+        pmf[k + 1] = pmf[k] * ((double)(successes - k) * (draws - k)) /
+                     ((k + 1.0) * (failures - draws + k + 1.0));
+    }
+    for (int k = mode; k > first; k--) {
+        pmf[k - 1] = pmf[k] * ((double)k * (failures - draws + k)) /
+                     (((double)successes - k + 1.0) * ((double)draws - k + 1.0));
+    }
+    double total = 0;
+    for (int k = first; k <= last; k++) total += pmf[k];
+    for (int k = first; k <= last; k++) pmf[k] /= total;
+
+    if (cdf) {
+        double running = 0;
+        for (int k = 0; k <= last; k++) {
+            running += pmf[k];
+            cdf[k] = running < 1 ? running : 1;
+        }
+    }
+}
+
+// ==================== MULTINOMIAL DISTRIBUTION ====================
+
+// log n! - sum log x_i!, n = sum x_i
+double logMultinomialCoefficient(const int counts[], int categories) {
+    if (categories <= 0) return -HUGE_VAL;
+    long long n = 0;
+    double result = 0;
+    for (int i = 0; i < categories; i++) {
+        if (counts[i] < 0) return -HUGE_VAL;
+        n += counts[i];
+        result -= logFactorial(counts[i]);
+    }
+    if (n > INT_MAX) return -HUGE_VAL;
+    return result + logFactorial((int)n);
+}
+
+// log P = log multinomial coefficient + sum x_i log p_i
+double logMultinomialProbability(const int counts[], const double probabilities[], int categories) {
+    double result = logMultinomialCoefficient(counts, categories);
+    if (result == -HUGE_VAL) return -HUGE_VAL;
+    for (int i = 0; i < categories; i++) {
+        if (probabilities[i] < 0 || probabilities[i] > 1) return -HUGE_VAL;
+        if (counts[i] == 0) continue;  // Avoid 0 * log(0)
+        if (probabilities[i] == 0) return -HUGE_VAL;
+        result += counts[i] * log(probabilities[i]);
+    }
+    return result;
+}
+
+double multinomialProbability(const int counts[], const double probabilities[], int categories) {
+    return exp(logMultinomialProbability(counts, probabilities, categories));
+}
+
+// log p_i is taken once for all rows
+void multinomialProbabilityBatch(const int counts[], int rows, const double probabilities[],
+                                 int categories, double result[]) {
+    if (rows <= 0) return;
+    if (categories <= 0) {
+        for (int r = 0; r < rows; r++) result[r] = 0;
+        return;
+    }
+    std::vector<double> logP(categories);
+    bool valid = true;
+    for (int i = 0; i < categories; i++) {
+        if (probabilities[i] < 0 || probabilities[i] > 1) valid = false;
+        logP[i] = probabilities[i] > 0 ? log(probabilities[i]) : -HUGE_VAL;
+    }
+
+    for (int r = 0; r < rows; r++) {
+        const int* row = counts + r * (long long)categories;
+        double logValue = valid ? logMultinomialCoefficient(row, categories) : -HUGE_VAL;
+        for (int i = 0; i < categories && logValue != -HUGE_VAL; i++) {
+            if (row[i] == 0) continue;
+            logValue += row[i] * logP[i];
+        }
+        result[r] = exp(logValue);
+    }
 }
 
 // Expected value for discrete distribution
@@ -54,7 +363,8 @@ double variance(int values[], double probabilities[], int size) {
     double mean = expectedValue(values, probabilities, size);
     double var = 0;
     for (int i = 0; i < size; i++) {
-        var += probabilities[i] * pow(values[i] - mean, 2);
+        double deviation = values[i] - mean;
+        var += probabilities[i] * deviation * deviation;
     }
     return var;
 }
@@ -1,18 +1,90 @@
 #ifndef PROBABILITY_H
 #define PROBABILITY_H
 
-// Factorial function for probability calculations
+// Factorial function for probability calculations.
+// O(1) lookup in a compile-time table; returns -1 if n! overflows (n > 20)
 long long factorial(int n);
 
 // Permutation: nPr = n! / (n-r)!
+// O(1) for n <= 20; returns -1 if the result overflows long long
 long long permutation(int n, int r);
 
 // Combination: nCr = n! / (r! * (n-r)!)
+// O(1) from a compile-time Pascal table for n <= 66; returns -1 on overflow
 long long combination(int n, int r);
 
+// Natural log of n!, from a fixed table built once (lgamma beyond 4095).
+// Thread-safe: no call modifies shared state after the first
+double logFactorial(int n);
+
+// Natural log of nCr, valid for large n (-HUGE_VAL if r is out of range)
+double logCombination(int n, int r);
+
+// Precomputed factorials and inverse factorials modulo a prime for O(1) nCr mod p
+struct ModularBinomial {
+    long long* factorials;         // i! mod modulus, i = 0..maxN
+    long long* inverseFactorials;  // (i!)^-1 mod modulus, i = 0..maxN
+    int maxN;
+    long long modulus;
+};
+
+// Builds tables for n = 0..maxN in O(maxN). modulus must be a prime greater
+// than maxN and at most 3037000499 (so products fit in long long)
+bool initModularBinomial(ModularBinomial& table, int maxN, long long modulus);
+
+// Releases the modular tables
+void freeModularBinomial(ModularBinomial& table);
+
+// n! mod p
+long long modFactorial(const ModularBinomial& table, int n);
+
+// nPr mod p
+long long modPermutation(const ModularBinomial& table, int n, int r);
+
+// nCr mod p
+long long modCombination(const ModularBinomial& table, int n, int r);
+
+// base^exponent mod modulus
+long long modPower(long long base, long long exponent, long long modulus);
+
+// Natural log of the binomial probability P(X=k) (-HUGE_VAL if impossible)
+double logBinomialProbability(int n, int k, double p);
+
 // Binomial probability: P(X=k) = nCr * p^k * (1-p)^(n-k)
 double binomialProbability(int n, int k, double p);
 
+// Binomial PMF (and optionally CDF, may be nullptr) for k = 0..n in O(n).
+// pmf and cdf must hold n + 1 values.
+void binomialDistribution(int n, double p, double pmf[], double cdf[]);
+
+// Natural log of the hypergeometric probability: k successes in `draws` draws
+// without replacement from `population` items of which `successes` are
+// successes (-HUGE_VAL if impossible or the parameters are invalid)
+double logHypergeometricProbability(int population, int successes, int draws, int k);
+
+// Hypergeometric probability P(X=k), evaluated in log space
+double hypergeometricProbability(int population, int successes, int draws, int k);
+
+// Hypergeometric PMF (and optionally CDF, may be nullptr) for
+// k = 0..min(draws, successes) in O(support). pmf and cdf must hold
+// min(draws, successes) + 1 values; entries below the support are 0
+void hypergeometricDistribution(int population, int successes, int draws, double pmf[], double cdf[]);
+
+// Natural log of the multinomial coefficient n! / (x1! * ... * xk!)
+double logMultinomialCoefficient(const int counts[], int categories);
+
+// Natural log of the multinomial probability of counts[] given category
+// probabilities (-HUGE_VAL if impossible)
+double logMultinomialProbability(const int counts[], const double probabilities[], int categories);
+
+// Multinomial probability, evaluated in log space
+double multinomialProbability(const int counts[], const double probabilities[], int categories);
+
+// result[r] = multinomialProbability of row r of counts (rows x categories,
+// row-major) with log probabilities and log factorials computed once
+void multinomialProbabilityBatch(const int counts[], int rows, const double probabilities[],
+                                 int categories, double result[]);
+
 // Expected value for discrete distribution
 double expectedValue(int values[], double probabilities[], int size);
 
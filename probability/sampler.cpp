@@ -0,0 +1,398 @@
+#include "sampler.h"
+#include <cmath>
+
+// ==================== GENERATOR ====================
+
+static inline uint64_t rotateLeft(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+static uint64_t splitmix64(uint64_t& x) {
+    uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+void seedRandom(RandomGenerator& rng, uint64_t seed) {
+    for (int i = 0; i < 4; i++) rng.state[i] = splitmix64(seed);
+}
+
+uint64_t nextRandom(RandomGenerator& rng) {
+    uint64_t* s = rng.state;
+    uint64_t result = rotateLeft(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotateLeft(s[3], 45);
+    return result;
+}
+
+void jumpRandom(RandomGenerator& rng) {
+    static const uint64_t jump[] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                                    0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+    uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    for (int i = 0; i < 4; i++) {
+        for (int b = 0; b < 64; b++) {
+            if (jump[i] & (1ULL << b)) {
+                s0 ^= rng.state[0];
+                s1 ^= rng.state[1];
+                s2 ^= rng.state[2];
+                s3 ^= rng.state[3];
+            }
+            nextRandom(rng);
+        }
+    }
+    rng.state[0] = s0;
+    rng.state[1] = s1;
+    rng.state[2] = s2;
+    rng.state[3] = s3;
+}
+
+// Top 53 bits scaled to [0, 1)
+static inline double toUniform(uint64_t bits) {
+    return (bits >> 11) * (1.0 / 9007199254740992.0);  // 2^-53
+}
+
+double nextUniform(RandomGenerator& rng) {
+    return toUniform(nextRandom(rng));
+}
+
+// ==================== NORMAL (ZIGGURAT) ====================
+
+// Doornik's ZIGNOR layout: 128 equal-area layers, tail start R, layer area V
+static const int ZIGGURAT_LAYERS = 128;
+static const double ZIGGURAT_R = 3.442619855899;
+static const double ZIGGURAT_V = 9.91256303526217e-3;
+
+struct ZigguratTables {
+    double x[ZIGGURAT_LAYERS + 1];  // Layer right edges, x[0] = V / f(R), x[LAYERS] = 0
+    double ratio[ZIGGURAT_LAYERS];  // x[i+1] / x[i]: fast-accept bound inside layer i
+    ZigguratTables() {
+        double f = exp(-0.5 * ZIGGURAT_R * ZIGGURAT_R);
+        x[0] = ZIGGURAT_V / f;
+        x[1] = ZIGGURAT_R;
+        x[ZIGGURAT_LAYERS] = 0;
+        for (int i = 2; i < ZIGGURAT_LAYERS; i++) {
+            x[i] = sqrt(-2.0 * log(ZIGGURAT_V / x[i - 1] + f));
+            f = exp(-0.5 * x[i] * x[i]);
+        }
+        for (int i = 0; i < ZIGGURAT_LAYERS; i++) ratio[i] = x[i + 1] / x[i];
+    }
+};
+
+static const ZigguratTables zigguratTables;
+
+// Marsaglia's tail algorithm for |z| > R
+static double normalTail(RandomGenerator& rng, bool negative) {
+    double x, y;
+    do {
+        x = log(1.0 - nextUniform(rng)) / ZIGGURAT_R;
+        y = log(1.0 - nextUniform(rng));
+    } while (-2.0 * y < x * x);
+    return negative ? x - ZIGGURAT_R : ZIGGURAT_R - x;
+}
+
+// Standard normal: ~99% of draws take the fast path (one random, one compare)
+static double standardNormal(RandomGenerator& rng) {
+    const ZigguratTables& z = zigguratTables;
+    for (;;) {
+        uint64_t bits = nextRandom(rng);
+        int layer = (int)(bits & (ZIGGURAT_LAYERS - 1));  // Low 7 bits pick the layer
+        double u = 2.0 * toUniform(bits) - 1.0;           // Top 53 bits give the position
+        if (fabs(u) < z.ratio[layer]) return u * z.x[layer];
+        if (layer == 0) return normalTail(rng, u < 0);
+        double x = u * z.x[layer];
+        double f0 = exp(-0.5 * (z.x[layer] * z.x[layer] - x * x));
+        double f1 = exp(-0.5 * (z.x[layer + 1] * z.x[layer + 1] - x * x));
+        if (f1 + nextUniform(rng) * (f0 - f1) < 1.0) return x;
+    }
+}
+
+double sampleNormal(RandomGenerator& rng, double mean, double stdev) {
+    return mean + stdev * standardNormal(rng);
+}
+
+void fillNormal(RandomGenerator& rng, double out[], int count, double mean, double stdev) {
+    for (int i = 0; i < count; i++) out[i] = mean + stdev * standardNormal(rng);
+}
+
+void fillUniform(RandomGenerator& rng, double out[], int count) {
+    for (int i = 0; i < count; i++) out[i] = toUniform(nextRandom(rng));
+}
+
+// ==================== POISSON ====================
+
+// Constants for Hormann's PTRS transformed rejection (lambda >= 10)
+struct PoissonSetup {
+    double lambda;
+    double expNegLambda;  // Multiplication method bound (lambda < 10)
+    double logLambda;
+    double b, a, invAlpha, vr;
+};
+
+static PoissonSetup makePoissonSetup(double lambda) {
+    PoissonSetup s;
+    s.lambda = lambda;
+    s.expNegLambda = exp(-lambda);
+    s.logLambda = log(lambda);
+    s.b = 0.931 + 2.53 * sqrt(lambda);
+    s.a = -0.059 + 0.02483 * s.b;
+    s.invAlpha = 1.1239 + 1.1328 / (s.b - 3.4);
+    s.vr = 0.9277 - 3.6224 / (s.b - 2.0);
+    return s;
+}
+
+static int poissonDraw(RandomGenerator& rng, const PoissonSetup& s) {
+    if (s.lambda <= 0) return 0;
+    if (s.lambda < 10) {  // Multiply uniforms until the product drops below e^-lambda
+        int k = 0;
+        double product = nextUniform(rng);
+        while (product > s.expNegLambda) {
+            k++;
+            product *= nextUniform(rng);
+        }
+        return k;
+    }
+    for (;;) {
+        double u = nextUniform(rng) - 0.5;
+        double v = nextUniform(rng);
+        double us = 0.5 - fabs(u);
+        int k = (int)floor((2.0 * s.a / us + s.b) * u + s.lambda + 0.43);
+        if (us >= 0.07 && v <= s.vr) return k;  // Squeeze acceptance
+        if (k < 0 || (us < 0.013 && v > us)) continue;
+        if (log(v) + log(s.invAlpha) - log(s.a / (us * us) + s.b) <=
+            -s.lambda + k * s.logLambda - lgamma(k + 1.0))
+            return k;
+    }
+}
+
+int samplePoisson(RandomGenerator& rng, double lambda) {
+    return poissonDraw(rng, makePoissonSetup(lambda));
+}
+
+void fillPoisson(RandomGenerator& rng, int out[], int count, double lambda) {
+    PoissonSetup s = makePoissonSetup(lambda);
+    for (int i = 0; i < count; i++) out[i] = poissonDraw(rng, s);
+}
+
+// ==================== BINOMIAL ====================
+
+// Setup for inversion (small mean) or BTPE (Kachitvichyanukul & Schmeiser 1988)
+struct BinomialSetup {
+    int n;
+    double p;       // Original p
+    double r, q;    // r = min(p, 1-p), q = 1 - r
+    bool useBtpe;
+    double qn, np, bound;                                 // Inversion
+    int m;                                                // BTPE mode
+    double nrq, xm, xl, xr, c, laml, lamr, p1, p2, p3, p4;  // BTPE regions
+};
+
+static BinomialSetup makeBinomialSetup(int n, double p) {
+    BinomialSetup s;
+    s.n = n;
+    s.p = p;
+    s.r = p < 0.5 ? p : 1.0 - p;
+    s.q = 1.0 - s.r;
+    s.useBtpe = n * s.r >= 30.0;
+    if (!s.useBtpe) {
+        s.qn = exp(n * log(s.q));
+        s.np = n * s.r;
+        s.bound = s.np + 10.0 * sqrt(s.np * s.q + 1.0);
+        if (s.bound > n) s.bound = n;
+        return s;
+    }
+    double fm = n * s.r + s.r;
+    s.m = (int)floor(fm);
+    s.nrq = n * s.r * s.q;
+    s.p1 = floor(2.195 * sqrt(s.nrq) - 4.6 * s.q) + 0.5;
+    s.xm = s.m + 0.5;
+    s.xl = s.xm - s.p1;
+    s.xr = s.xm + s.p1;
+    s.c = 0.134 + 20.5 / (15.3 + s.m);
+    double a = (fm - s.xl) / (fm - s.xl * s.r);
+    s.laml = a * (1.0 + a / 2.0);
+    a = (s.xr - fm) / (s.xr * s.q);
+    s.lamr = a * (1.0 + a / 2.0);
+    s.p2 = s.p1 * (1.0 + 2.0 * s.c);
+    s.p3 = s.p2 + s.c / s.laml;
+    s.p4 = s.p3 + s.c / s.lamr;
+    return s;
+}
+
+// Sequential search from k = 0 using the PMF ratio; restarts past the bound
+static int binomialInversion(RandomGenerator& rng, const BinomialSetup& s) {
+    int k = 0;
+    double px = s.qn;
+    double u = nextUniform(rng);
+    while (u > px) {
+        k++;
+        if (k > s.bound) {
+            k = 0;
+            px = s.qn;
+            u = nextUniform(rng);
+        } else {
+            u -= px;
+            px = ((s.n - k + 1) * s.r * px) / (k * s.q);
+        }
+    }
+    return k;
+}
+
+// Stirling-series correction term used by the BTPE final acceptance test
+static double stirlingTail(double v) {
+    double v2 = v * v;
+    return (13680.0 - (462.0 - (132.0 - (99.0 - 140.0 / v2) / v2) / v2) / v2) / v / 166320.0;
+}
+
+// BTPE: triangle/parallelogram/exponential-tail hat with squeeze tests
+static int binomialBtpe(RandomGenerator& rng, const BinomialSetup& s) {
+    const int n = s.n;
+    const int m = s.m;
+    int y;
+    for (;;) {
+        double u = nextUniform(rng) * s.p4;
+        double v = nextUniform(rng);
+        if (u <= s.p1) {  // Triangular region: immediate accept
+            y = (int)floor(s.xm - s.p1 * v + u);
+            break;
+        }
+        if (u <= s.p2) {  // Parallelogram region
+            double x = s.xl + (u - s.p1) / s.c;
+            v = v * s.c + 1.0 - fabs(m - x + 0.5) / s.p1;
+            if (v > 1.0) continue;
+            y = (int)floor(x);
+        } else if (u <= s.p3) {  // Left exponential tail
+            if (v == 0.0) continue;
+            double yl = floor(s.xl + log(v) / s.laml);
+            if (yl < 0) continue;
+            y = (int)yl;
+            v = v * (u - s.p2) * s.laml;
+        } else {  // Right exponential tail
+            if (v == 0.0) continue;
+            double yr = floor(s.xr - log(v) / s.lamr);
+            if (yr > n) continue;
+            y = (int)yr;
+            v = v * (u - s.p3) * s.lamr;
+        }
+
+        int k = y > m ? y - m : m - y;
+        if (k <= 20 || k >= s.nrq / 2.0 - 1.0) {
+            // Evaluate f(y) / f(m) explicitly with the PMF recurrence
+            double ratio = s.r / s.q;
+            double a = ratio * (n + 1);
+            double f = 1.0;
+            if (m < y) {
+                for (int i = m + 1; i <= y; i++) f *= (a / i - ratio);
+            } else if (m > y) {
+                for (int i = y + 1; i <= m; i++) f /= (a / i - ratio);
+            }
+            if (v <= f) break;
+            continue;
+        }
+
+        // Squeeze on log(f(y) / f(m)), then the exact Stirling-based bound
+        double rho = (k / s.nrq) * ((k * (k / 3.0 + 0.625) + 0.1666666666666667) / s.nrq + 0.5);
+        double t = -(double)k * k / (2.0 * s.nrq);
+        double logV = log(v);
+        if (logV < t - rho) break;
+        if (logV > t + rho) continue;
+        double x1 = y + 1.0;
+        double f1 = m + 1.0;
+        double z = n + 1.0 - m;
+        double w = n - y + 1.0;
+        double bound = s.xm * log(f1 / x1) + (n - m + 0.5) * log(z / w) +
+                       (y - m) * log(w * s.r / (x1 * s.q)) +
+                       stirlingTail(f1) + stirlingTail(z) + stirlingTail(x1) + stirlingTail(w);
+        if (logV <= bound) break;
+    }
+    return y;
+}
+
+static int binomialDraw(RandomGenerator& rng, const BinomialSetup& s) {
+    if (s.n <= 0 || s.p <= 0) return 0;
+    if (s.p >= 1) return s.n;
+    int y = s.useBtpe ? binomialBtpe(rng, s) : binomialInversion(rng, s);
+    return s.p > 0.5 ? s.n - y : y;
+}
+
+int sampleBinomial(RandomGenerator& rng, int n, double p) {
+    return binomialDraw(rng, makeBinomialSetup(n, p));
+}
+
+void fillBinomial(RandomGenerator& rng, int out[], int count, int n, double p) {
+    BinomialSetup s = makeBinomialSetup(n, p);
+    for (int i = 0; i < count; i++) out[i] = binomialDraw(rng, s);
+}
+
+// ==================== DISCRETE (ALIAS METHOD) ====================
+
+// Vose's O(n) construction: pair each under-full column with an over-full one
+bool buildAliasTable(AliasTable& table, const int values[], const double probabilities[], int size) {
+    table.threshold = nullptr;
+    table.alias = nullptr;
+    table.values = nullptr;
+    table.size = 0;
+    if (size <= 0) return false;
+    double total = 0;
+    for (int i = 0; i < size; i++) {
+        if (!(probabilities[i] >= 0)) return false;
+        total += probabilities[i];
+    }
+    if (total <= 0) return false;
+
+    table.threshold = new double[size];
+    table.alias = new int[size];
+    table.values = new int[size];
+    table.size = size;
+    int* small = new int[size];
+    int* large = new int[size];
+    int smallCount = 0, largeCount = 0;
+    for (int i = 0; i < size; i++) {
+        table.values[i] = values[i];
+        table.alias[i] = i;
+        table.threshold[i] = probabilities[i] * size / total;
+        if (table.threshold[i] < 1.0) small[smallCount++] = i;
+        else large[largeCount++] = i;
+    }
+    while (smallCount > 0 && largeCount > 0) {
+        int s = small[--smallCount];
+        int l = large[--largeCount];
+        table.alias[s] = l;
+        table.threshold[l] -= 1.0 - table.threshold[s];
+        if (table.threshold[l] < 1.0) small[smallCount++] = l;
+        else large[largeCount++] = l;
+    }
+    // Leftovers are full columns up to rounding
+    while (largeCount > 0) table.threshold[large[--largeCount]] = 1.0;
+    while (smallCount > 0) table.threshold[small[--smallCount]] = 1.0;
+    delete[] small;
+    delete[] large;
+    return true;
+}
+
+void freeAliasTable(AliasTable& table) {
+    delete[] table.threshold;
+    delete[] table.alias;
+    delete[] table.values;
+    table.threshold = nullptr;
+    table.alias = nullptr;
+    table.values = nullptr;
+    table.size = 0;
+}
+
+// High 32 bits pick the column (multiply-shift, no modulo), low bits the coin
+int sampleAlias(RandomGenerator& rng, const AliasTable& table) {
+    uint64_t bits = nextRandom(rng);
+    int column = (int)(((bits >> 32) * (uint64_t)table.size) >> 32);
+    double coin = (bits & 0xffffffffULL) * (1.0 / 4294967296.0);  // 2^-32
+    return table.values[coin < table.threshold[column] ? column : table.alias[column]];
+}
+
+void fillDiscrete(RandomGenerator& rng, const AliasTable& table, int out[], int count) {
+    for (int i = 0; i < count; i++) out[i] = sampleAlias(rng, table);
+}
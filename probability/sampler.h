@@ -0,0 +1,79 @@
+#ifndef SAMPLER_H
+#define SAMPLER_H
+
+#include <cstdint>
+
+// Random variate generation for Monte Carlo simulation.
+// Every fill function produces exactly the same values as the matching
+// number of single-draw calls, so batch and scalar code stay reproducible.
+
+// ==================== GENERATOR ====================
+
+// xoshiro256** pseudo-random generator (period 2^256 - 1)
+struct RandomGenerator {
+    uint64_t state[4];
+};
+
+// Seeds the generator from a 64-bit value (expanded with splitmix64)
+void seedRandom(RandomGenerator& rng, uint64_t seed);
+
+// Advances the generator by 2^128 draws. Calling it k times on copies of one
+// seeded generator gives k non-overlapping streams for parallel work
+void jumpRandom(RandomGenerator& rng);
+
+// Next raw 64-bit value
+uint64_t nextRandom(RandomGenerator& rng);
+
+// Uniform double in [0, 1) with 53 random bits
+double nextUniform(RandomGenerator& rng);
+
+// ==================== SINGLE DRAWS ====================
+
+// Normal variate (ziggurat method, 128 layers)
+double sampleNormal(RandomGenerator& rng, double mean, double stdev);
+
+// Poisson variate: multiplication method for lambda < 10, PTRS rejection above
+int samplePoisson(RandomGenerator& rng, double lambda);
+
+// Binomial variate: inversion for n*min(p,1-p) < 30, BTPE above
+int sampleBinomial(RandomGenerator& rng, int n, double p);
+
+// ==================== BATCH FILLS ====================
+
+// out[i] = uniform in [0, 1)
+void fillUniform(RandomGenerator& rng, double out[], int count);
+
+// out[i] = normal(mean, stdev)
+void fillNormal(RandomGenerator& rng, double out[], int count, double mean, double stdev);
+
+// out[i] = Poisson(lambda); algorithm constants are computed once per call
+void fillPoisson(RandomGenerator& rng, int out[], int count, double lambda);
+
+// out[i] = Binomial(n, p); BTPE setup is computed once per call
+void fillBinomial(RandomGenerator& rng, int out[], int count, int n, double p);
+
+// ==================== DISCRETE (ALIAS METHOD) ====================
+
+// Walker/Vose alias table for O(1) sampling from a finite distribution
+struct AliasTable {
+    double* threshold;  // Probability of keeping column i instead of its alias
+    int* alias;         // Alternative column for each i
+    int* values;        // Value returned for each column
+    int size;
+};
+
+// Builds an alias table in O(size) from the same values[]/probabilities[]
+// arrays used by expectedValue(). Probabilities are normalized; returns false
+// if size <= 0, any probability is negative, or they sum to 0
+bool buildAliasTable(AliasTable& table, const int values[], const double probabilities[], int size);
+
+// Releases the alias table
+void freeAliasTable(AliasTable& table);
+
+// One draw in O(1): a single 64-bit random picks both column and coin
+int sampleAlias(RandomGenerator& rng, const AliasTable& table);
+
+// out[i] = sampleAlias(rng, table)
+void fillDiscrete(RandomGenerator& rng, const AliasTable& table, int out[], int count);
+
+#endif
@@ -0,0 +1,243 @@
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include "probability.h"
+#include "distributions.h"
+#include "sampler.h"
+#include "discrete.h"
+#include "montecarlo.h"
+#include "convolution.h"
+#include "bignum.h"
+#include "../cstats/cstats.h"
+
+using namespace std;
+
+// Build: g++ -O2 -std=c++17 -pthread test_all.cpp probability.cpp distributions.cpp
+//        sampler.cpp discrete.cpp montecarlo.cpp convolution.cpp bignum.cpp ../cstats/cstats.cpp
+
+// Test counter
+int passed = 0;
+int failed = 0;
+
+// Helper function to check if two doubles are approximately equal
+bool approxEqual(double a, double b, double epsilon = 0.0001) {
+    return fabs(a - b) < epsilon;
+}
+
+// Test macro for displaying results
+#define TEST_RESULT(name, result) \
+    cout << name << ": " << result << endl;
+
+// Test macro for pass/fail (failures are named so they can be found)
+#define TEST(name, condition) \
+    if (condition) { \
+        passed++; \
+    } else { \
+        failed++; \
+        cout << "FAILED: " << name << endl; \
+    }
+
+// Monte Carlo kernel: 1.0 when a uniform draw falls below *threshold
+static double belowThreshold(RandomGenerator& rng, void* context) {
+    return nextUniform(rng) < *(const double*)context ? 1.0 : 0.0;
+}
+
+int main() {
+    cout << "=== COMPREHENSIVE PROBABILITY TEST SUITE ===" << endl << endl;
+    cout << setprecision(10);
+
+    cout << "--- COMBINATORICS ---" << endl;
+    TEST("factorial(20)", factorial(20) == 2432902008176640000LL);
+    TEST("factorial(21) overflows", factorial(21) == -1);
+    TEST("permutation(10, 3)", permutation(10, 3) == 720);
+    TEST("combination(66, 33)", combination(66, 33) == 7219428434016265740LL);
+    TEST_RESULT("logCombination(50, 25)", logCombination(50, 25));
+    TEST("logCombination(50, 25)", approxEqual(logCombination(50, 25), 32.470556505812, 1e-9));
+    TEST("logCombination out of range", logCombination(5, 6) == -HUGE_VAL);
+    TEST("logFactorial table and lgamma agree", logFactorial(4095) == lgamma(4096.0) && logFactorial(4096) == lgamma(4097.0));
+    ModularBinomial modTable;
+    TEST("initModularBinomial", initModularBinomial(modTable, 1000, 1000000007LL));
+    TEST("modCombination(1000, 500)", modCombination(modTable, 1000, 500) == 159835829LL);
+    freeModularBinomial(modTable);
+
+    cout << endl << "--- BINOMIAL / HYPERGEOMETRIC / MULTINOMIAL ---" << endl;
+    TEST_RESULT("binomialProbability(10, 3, 0.3)", binomialProbability(10, 3, 0.3));
+    TEST("binomialProbability(10, 3, 0.3)", approxEqual(binomialProbability(10, 3, 0.3), 0.266827932, 1e-9));
+    double binomialPmf[11], binomialCdf[11];
+    binomialDistribution(10, 0.3, binomialPmf, binomialCdf);
+    double pmfTotal = 0.0;
+    for (int k = 0; k <= 10; k++) pmfTotal += binomialPmf[k];
+    TEST("binomialDistribution PMF sums to 1", approxEqual(pmfTotal, 1.0, 1e-12));
+    TEST("binomialDistribution CDF ends at 1", approxEqual(binomialCdf[10], 1.0, 1e-12));
+    TEST("binomialDistribution matches binomialProbability", approxEqual(binomialPmf[3], binomialProbability(10, 3, 0.3), 1e-12));
+    TEST_RESULT("hypergeometricProbability(50, 5, 10, 1)", hypergeometricProbability(50, 5, 10, 1));
+    TEST("hypergeometricProbability(50, 5, 10, 1)", approxEqual(hypergeometricProbability(50, 5, 10, 1), 0.431337197, 1e-9));
+    double hyperPmf[6], hyperCdf[6];
+    hypergeometricDistribution(50, 5, 10, hyperPmf, hyperCdf);
+    TEST("hypergeometricDistribution CDF ends at 1", approxEqual(hyperCdf[5], 1.0, 1e-12));
+    TEST("hypergeometricDistribution matches single term", approxEqual(hyperPmf[1], 0.431337197, 1e-9));
+    int counts[] = {1, 1, 1};
+    double thirds[] = {1.0 / 3, 1.0 / 3, 1.0 / 3};
+    TEST("multinomialProbability(1,1,1)", approxEqual(multinomialProbability(counts, thirds, 3), 6.0 / 27.0, 1e-12));
+
+    cout << endl << "--- DISTRIBUTIONS ---" << endl;
+    TEST_RESULT("normalCdf(1.96)", normalCdf(1.96, 0, 1));
+    TEST("normalCdf(1.96)", approxEqual(normalCdf(1.96, 0, 1), 0.9750021049, 1e-9));
+    TEST("normalQuantile(0.975)", approxEqual(normalQuantile(0.975, 0, 1), 1.959963985, 1e-8));
+    TEST("studentTCdf(2.570582, 5)", approxEqual(studentTCdf(2.570582, 5), 0.975, 1e-6));
+    TEST("studentTQuantile(0.975, 5)", approxEqual(studentTQuantile(0.975, 5), 2.570582, 1e-6));
+    TEST("chiSquareCdf(3.841459, 1)", approxEqual(chiSquareCdf(3.841459, 1), 0.95, 1e-6));
+    TEST("chiSquareQuantile(0.95, 1)", approxEqual(chiSquareQuantile(0.95, 1), 3.841459, 1e-5));
+    TEST("gammaCdf(2, 1, 1) = 1 - e^-2", approxEqual(gammaCdf(2, 1, 1), 1.0 - exp(-2.0), 1e-12));
+    TEST("betaCdf(0.5, 2, 3) = 11/16", approxEqual(betaCdf(0.5, 2, 3), 0.6875, 1e-12));
+    TEST("betaQuantile(11/16, 2, 3)", approxEqual(betaQuantile(0.6875, 2, 3), 0.5, 1e-9));
+    double poissonTotal = 0.0;
+    for (int k = 0; k <= 100; k++) poissonTotal += poissonPmf(k, 4.0);
+    TEST("poissonPmf sums to 1", approxEqual(poissonTotal, 1.0, 1e-12));
+    TEST("poissonCdf(3, 4)", approxEqual(poissonCdf(3, 4.0), 0.4334701204, 1e-9));
+    TEST("poissonQuantile(0.5, 4)", poissonQuantile(0.5, 4.0) == 4);
+    TEST("betaCdf matches cstats", approxEqual(betaCdf(0.3, 2.5, 0.5), regularizedIncompleteBeta(2.5, 0.5, 0.3), 1e-14));
+    TEST("poissonCdf matches cstats", approxEqual(poissonCdf(6, 7.0), regularizedGammaQ(7.0, 7.0), 1e-14));
+    double tValues[] = {-3.0, -0.5, 0.0, 1.2, 4.0};
+    double batch[5];
+    studentTCdfBatch(tValues, batch, 5, 7.0);
+    bool batchMatches = true;
+    for (int i = 0; i < 5; i++) batchMatches = batchMatches && approxEqual(batch[i], studentTCdf(tValues[i], 7.0), 1e-14);
+    TEST("studentTCdfBatch matches studentTCdf", batchMatches);
+    normalCdfBatch(tValues, batch, 5, 0.0, 1.0);
+    batchMatches = true;
+    for (int i = 0; i < 5; i++) batchMatches = batchMatches && approxEqual(batch[i], normalCdf(tValues[i], 0, 1), 1e-7);
+    TEST("normalCdfBatch within 7.5e-8", batchMatches);
+
+    cout << endl << "--- SAMPLING ---" << endl;
+    RandomGenerator rng, replay;
+    seedRandom(rng, 42);
+    replay = rng;
+    double uniforms[8];
+    fillUniform(rng, uniforms, 8);
+    bool sameStream = true;
+    for (int i = 0; i < 8; i++) sameStream = sameStream && uniforms[i] == nextUniform(replay);
+    TEST("fillUniform matches nextUniform", sameStream);
+    const int draws = 200000;
+    double* normals = new double[draws];
+    fillNormal(rng, normals, draws, 3.0, 2.0);
+    TEST_RESULT("fillNormal(3, 2) mean", mean(normals, draws));
+    TEST("fillNormal(3, 2) mean", approxEqual(mean(normals, draws), 3.0, 0.03));
+    TEST("fillNormal(3, 2) stdev", approxEqual(sampleStdev(normals, draws), 2.0, 0.03));
+    delete[] normals;
+    int* counts2 = new int[draws];
+    double* asDouble = new double[draws];
+    fillPoisson(rng, counts2, draws, 50.0);
+    for (int i = 0; i < draws; i++) asDouble[i] = counts2[i];
+    TEST("fillPoisson(50) mean and variance", approxEqual(mean(asDouble, draws), 50.0, 0.15) &&
+         approxEqual(sampleVariance(asDouble, draws), 50.0, 1.5));
+    fillBinomial(rng, counts2, draws, 1000, 0.3);
+    for (int i = 0; i < draws; i++) asDouble[i] = counts2[i];
+    TEST("fillBinomial(1000, 0.3) mean and variance", approxEqual(mean(asDouble, draws), 300.0, 0.3) &&
+         approxEqual(sampleVariance(asDouble, draws), 210.0, 6.0));
+    delete[] asDouble;
+
+    int faces[] = {1, 2, 3};
+    double weights[] = {0.2, 0.5, 0.3};
+    AliasTable alias;
+    TEST("buildAliasTable", buildAliasTable(alias, faces, weights, 3));
+    fillDiscrete(rng, alias, counts2, draws);
+    int hits[4] = {0, 0, 0, 0};
+    for (int i = 0; i < draws; i++) hits[counts2[i]]++;
+    TEST("fillDiscrete frequencies", approxEqual(hits[1] / (double)draws, 0.2, 0.005) &&
+         approxEqual(hits[2] / (double)draws, 0.5, 0.005) && approxEqual(hits[3] / (double)draws, 0.3, 0.005));
+    freeAliasTable(alias);
+    delete[] counts2;
+
+    cout << endl << "--- DISCRETE DISTRIBUTION ---" << endl;
+    int values[] = {3, 1, 2, 3};
+    double probabilities[] = {1, 2, 3, 4};  // Unnormalized; 3 appears twice
+    DiscreteDistribution dist;
+    TEST("initDiscreteDistribution", initDiscreteDistribution(dist, values, probabilities, 4));
+    TEST("discrete support merged", dist.size == 3 && dist.values[0] == 1 && dist.values[2] == 3);
+    TEST_RESULT("discreteMean", discreteMean(dist));
+    TEST("discreteMean", approxEqual(discreteMean(dist), 2.3, 1e-12));
+    TEST("discreteMean matches expectedValue", approxEqual(discreteMean(dist), expectedValue(values, probabilities, 4) / 10.0, 1e-12));
+    TEST("discreteVariance", approxEqual(discreteVariance(dist), 0.61, 1e-12));
+    TEST("discretePmf(3)", approxEqual(discretePmf(dist, 3), 0.5, 1e-12) && discretePmf(dist, 4) == 0.0);
+    TEST("discreteCdf(2.5)", approxEqual(discreteCdf(dist, 2.5), 0.5, 1e-12));
+    TEST("discreteQuantile(0.5)", discreteQuantile(dist, 0.5) == 2);
+    TEST("discreteQuantile(0.51)", discreteQuantile(dist, 0.51) == 3);
+    freeDiscreteDistribution(dist);
+    int edgeValues[] = {0, 1, 2, 3, 2};
+    double edgeProbabilities[] = {0, 0.5, 0.5, 0, 0};  // Zero mass at both ends
+    TEST("initDiscreteDistribution(zero-mass ends)", initDiscreteDistribution(dist, edgeValues, edgeProbabilities, 5));
+    TEST("zero-mass values dropped", dist.size == 2 && discretePmf(dist, 3) == 0.0 && approxEqual(discreteMean(dist), 1.5, 1e-12));
+    TEST("discreteQuantile(0) skips zero mass", discreteQuantile(dist, 0.0) == 1);
+    TEST("discreteQuantile(1) skips zero mass", discreteQuantile(dist, 1.0) == 2);
+    freeDiscreteDistribution(dist);
+
+    cout << endl << "--- CONVOLUTION ---" << endl;
+    int dieFaces[] = {1, 2, 3, 4, 5, 6};
+    double dieProbabilities[] = {1.0 / 6, 1.0 / 6, 1.0 / 6, 1.0 / 6, 1.0 / 6, 1.0 / 6};
+    LatticeDistribution die, twoDice, manyDice;
+    TEST("makeLatticeDistribution", makeLatticeDistribution(die, dieFaces, dieProbabilities, 6));
+    TEST("convolveDistributions(die, die)", convolveDistributions(twoDice, die, die));
+    TEST("two dice: P(7) = 6/36", twoDice.offset == 2 && twoDice.size == 11 &&
+         approxEqual(twoDice.pmf[7 - twoDice.offset], 6.0 / 36.0, 1e-15));
+    TEST("convolutionPower(die, 100)", convolutionPower(manyDice, die, 100));
+    double diceTotal = 0.0, diceMean = 0.0;
+    for (int i = 0; i < manyDice.size; i++) {
+        diceTotal += manyDice.pmf[i];
+        diceMean += (manyDice.offset + i) * manyDice.pmf[i];
+    }
+    TEST_RESULT("100 dice mean", diceMean);
+    TEST("100 dice PMF sums to 1 with mean 350", approxEqual(diceTotal, 1.0, 1e-12) && approxEqual(diceMean, 350.0, 1e-9));
+    freeLatticeDistribution(die);
+    freeLatticeDistribution(twoDice);
+    freeLatticeDistribution(manyDice);
+
+    cout << endl << "--- BIG INTEGERS ---" << endl;
+    TEST("bigFactorial(20)", bigToString(bigFactorial(20)) == "2432902008176640000");
+    TEST("bigFactorial(25)", bigToString(bigFactorial(25)) == "15511210043330985984000000");
+    TEST("bigFactorial(100)", bigToString(bigFactorial(100)) ==
+         "93326215443944152681699238856266700490715968264381621468592963895217599993229915608941463976156518286253697920827223758251185210916864000000000000000000000000");
+    TEST("bigCombination(100, 50)", bigToString(bigCombination(100, 50)) == "100891344545564193334812497256");
+    TEST("bigPermutation(10, 3)", bigToString(bigPermutation(10, 3)) == "720");
+    TEST("bigCombination invalid is zero", bigIsZero(bigCombination(5, 6)) == 1);
+    TEST("bigMultiply matches bigFactorial", bigCompare(bigMultiply(bigFactorial(60), bigFromUnsigned(61)), bigFactorial(61)) == 0);
+
+    cout << endl << "--- MONTE CARLO ---" << endl;
+    MonteCarloOptions options;
+    defaultMonteCarloOptions(options);
+    options.maxTrials = 1000000;
+    options.threads = 4;
+    double quarter = 0.25;
+    MonteCarloAccumulator estimate, serial;
+    runMonteCarlo(belowThreshold, &quarter, options, estimate);
+    TEST_RESULT("P(U < 0.25) estimate", estimate.mean);
+    TEST("P(U < 0.25) estimate", estimate.count == 1000000 && approxEqual(estimate.mean, 0.25, 0.003));
+    options.threads = 1;
+    runMonteCarlo(belowThreshold, &quarter, options, serial);
+    TEST("runMonteCarlo independent of thread count", serial.mean == estimate.mean && serial.m2 == estimate.m2);
+    options.targetStandardError = 0.001;
+    TEST("runMonteCarlo early stop", runMonteCarlo(belowThreshold, &quarter, options, estimate) &&
+         estimate.count < options.maxTrials && accumulatorStandardError(estimate) <= 0.001);
+    double rare = 1e-7;  // Tail event: typically no hits before the first stopping check
+    options.maxTrials = 1 << 20;
+    options.targetStandardError = 1e-8;
+    options.threads = 0;
+    TEST("runMonteCarlo does not stop on a zero-variance rare event",
+         !runMonteCarlo(belowThreshold, &rare, options, estimate) && estimate.count == options.maxTrials);
+    options.minEvents = 0;
+    TEST("runMonteCarlo with minEvents 0 stops on zero variance",
+         runMonteCarlo(belowThreshold, &rare, options, estimate) && estimate.nonzero == 0);
+
+    cout << endl << "=== TEST RESULTS ===" << endl;
+    cout << "Passed: " << passed << endl;
+    cout << "Failed: " << failed << endl;
+    cout << "Total:  " << (passed + failed) << endl;
+
+    if (failed == 0) {
+        cout << endl << "*** ALL TESTS PASSED! ***" << endl;
+        return 0;
+    } else {
+        cout << endl << "*** SOME TESTS FAILED ***" << endl;
+        return 1;
+    }
+}